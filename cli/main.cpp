@@ -1,26 +1,34 @@
+#include <charconv>
 #include <cstdlib>
 #include <cstring>
 
 #include <fstream>
 #include <iostream>
+#include <optional>
+#include <sstream>
 #include <lyra/lyra.hpp>
 
 #include "thorin/config.h"
 #include "thorin/driver.h"
 
+#include "thorin/analyses/fingerprint.h"
 #include "thorin/be/dot/dot.h"
 #include "thorin/be/h/bootstrap.h"
+#include "thorin/fe/manifest.h"
 #include "thorin/fe/parser.h"
 #include "thorin/pass/optimize.h"
 #include "thorin/pass/pass.h"
 #include "thorin/pass/pipelinebuilder.h"
 #include "thorin/phase/phase.h"
+#include "thorin/util/cache.h"
 #include "thorin/util/sys.h"
 
+#include "server.h"
+
 using namespace thorin;
 using namespace std::literals;
 
-enum Backends { Dot, H, LL, Md, Thorin, Num_Backends };
+enum Backends { C, Dot, Exe, H, LL, Md, Obj, Thorin, Num_Backends };
 
 int main(int argc, char** argv) {
     try {
@@ -30,7 +38,12 @@ int main(int argc, char** argv) {
         bool show_help         = false;
         bool show_version      = false;
         bool list_search_paths = false;
-        std::string input, prefix;
+        bool run               = false;
+        bool parallel_imports  = false;
+        bool manifest_key      = false;
+        bool stop_server       = false;
+        std::string input, prefix, cache_dir, profile, server, connect;
+        size_t cache_size = 256;
         std::string clang = sys::find_cmd("clang");
         std::vector<std::string> plugins, search_paths;
 #ifdef THORIN_ENABLE_CHECKS
@@ -52,16 +65,34 @@ int main(int argc, char** argv) {
             | lyra::opt(search_paths,   "path"                )["-P"]["--plugin-path"           ]("Path to search for plugins.")
             | lyra::opt(inc_verbose                           )["-V"]["--verbose"               ]("Verbose mode. Multiple -V options increase the verbosity. The maximum is 4.").cardinality(0, 4)
             | lyra::opt(opt,            "level"               )["-O"]["--optimize"              ]("Optimization level (default: 2).")
+            | lyra::opt(cache_dir,      "dir"                 )      ["--cache"                 ]("Reuses C/LLVM/object output from cache directory <dir> if neither input nor flags nor plugins have changed. --run reuses JIT-compiled code from there, too.")
+            | lyra::opt(cache_size,     "MiB"                 )      ["--cache-size"            ]("Evicts least recently used cache entries beyond this size (default: 256).")
+            | lyra::opt(manifest_key                          )      ["--manifest-key"          ]("Derives the --cache key from the tokens of the input's top-level declarations, its imports, and the plugins - without parsing anything. Upon a hit, parsing and optimization are skipped; upon a miss, the whole input is recompiled.")
+            | lyra::opt(parallel_imports                      )      ["--parallel-imports"      ]("Discovers and reads the whole import graph of the input in parallel before parsing it.")
+            | lyra::opt(server,         "socket"              )      ["--server"                ]("Starts a compile server in the background that keeps the plugins warm and compiles requests received on Unix domain socket <socket>.")
+            | lyra::opt(connect,        "socket"              )      ["--connect"               ]("Lets the compile server on <socket> compile the input. Supports -O, -V, -p, -P, the options that set flags, and all --output-* options but --output-h.")
+            | lyra::opt(stop_server                           )      ["--stop-server"           ]("Stops the compile server given via --connect.")
+            | lyra::opt(output[C     ], "file"                )      ["--output-c"              ]("Compiles the Thorin program to C99.")
             | lyra::opt(output[Dot   ], "file"                )      ["--output-dot"            ]("Emits the Thorin program as a graph using Graphviz' DOT language.")
+            | lyra::opt(output[Exe   ], "file"                )      ["--output-exe"            ]("Compiles the Thorin program to an executable via LLVM and clang.")
             | lyra::opt(output[H     ], "file"                )      ["--output-h"              ]("Emits a header file to be used to interface with a plugin in C++.")
             | lyra::opt(output[LL    ], "file"                )      ["--output-ll"             ]("Compiles the Thorin program to LLVM.")
             | lyra::opt(output[Md    ], "file"                )      ["--output-md"             ]("Emits the input formatted as Markdown.")
+            | lyra::opt(output[Obj   ], "file"                )      ["--output-obj"            ]("Compiles the Thorin program to a native object file in-process (requires LLVM support).")
             | lyra::opt(output[Thorin], "file"                )["-o"]["--output-thorin"         ]("Emits the Thorin program again.")
+            | lyra::opt(run                                   )["-r"]["--run"                   ]("JIT-compiles the Thorin program in-process and runs its 'main' (requires LLVM support).")
             | lyra::opt(flags.bootstrap                       )      ["--bootstrap"             ]("Puts thorin into \"bootstrap mode\". This means a '.plugin' directive has the same effect as an '.import' and will not load a library. In addition, no standard plugins will be loaded.")
             | lyra::opt(flags.dump_gid, "level"               )      ["--dump-gid"              ]("Dumps gid of inline expressions as a comment in output if <level> > 0. Use a <level> of 2 to also emit the gid of trivial defs.")
             | lyra::opt(flags.dump_recursive                  )      ["--dump-recursive"        ]("Dumps Thorin program with a simple recursive algorithm that is not readable again from Thorin but is less fragile and also works for broken Thorin programs.")
             | lyra::opt(flags.aggressive_lam_spec             )      ["--aggr-lam-spec"         ]("Overrides LamSpec behavior to follow recursive calls.")
             | lyra::opt(flags.scalerize_threshold, "threshold")      ["--scalerize-threshold"   ]("Thorin will not scalerize tuples/packs/sigmas/arrays with a number of elements greater than or equal this threshold.")
+            | lyra::opt(flags.ll_partitions, "n"              )      ["--ll-partitions"         ]("Splits the LLVM module for --output-exe into <n> partitions that are compiled by parallel clang invocations (default: 1).")
+            | lyra::opt(flags.stream_ll                       )      ["--stream-ll"             ]("Writes each function to the LLVM output as soon as it has been emitted instead of buffering the whole module.")
+            | lyra::opt(flags.lazy_imports                    )      ["--lazy-imports"          ]("Parses the bodies of named declarations in imported modules only when they are actually used.")
+            | lyra::opt(flags.recover                         )      ["--recover"               ]("Resumes parsing at the next declaration after an error and reports all errors in the input and its imports at once.")
+            | lyra::opt(flags.loop_hints                      )      ["--loop-hints"            ]("Forces LLVM to vectorize and unroll counted loops - as built by %affine.For - regardless of its cost model.")
+            | lyra::opt(flags.instrument                      )      ["--instrument"            ]("Counts executions of each basic block in the LLVM output. Upon exit, the program appends the counts to the file in $THORIN_PROFILE (default: 'thorin.prof').")
+            | lyra::opt(profile,        "file"                )      ["--profile"               ]("Uses the counts in <file> - as gathered with --instrument - to guide optimizations toward hot code.")
 #ifdef THORIN_ENABLE_CHECKS
             | lyra::opt(breakpoints,    "gid"                 )["-b"]["--break"                 ]("*Triggers breakpoint upon construction of node with global id <gid>. Useful when running in a debugger.")
             | lyra::opt(flags.reeval_breakpoints              )      ["--reeval-breakpoints"    ]("*Triggers breakpoint even upon unfying a node that has already been built.")
@@ -113,17 +144,59 @@ int main(int argc, char** argv) {
             if (output[be] == "-") {
                 os[be] = &std::cout;
             } else {
-                ofs[be].open(output[be]);
+                ofs[be].open(output[be], be == Exe || be == Obj ? std::ios::binary | std::ios::out : std::ios::out);
                 os[be] = &ofs[be];
             }
         }
 
+        // executables need to be executable
+        auto chmod_exe = [&]() {
+            if (!os[Exe] || !ofs[Exe].is_open()) return;
+            ofs[Exe].close();
+            fs::permissions(output[Exe], fs::perms::owner_exec | fs::perms::group_exec | fs::perms::others_exec,
+                            fs::perm_options::add);
+        };
+
+        static const std::array<const char*, Num_Backends> names = {"c", "dot", "exe", "h", "ll", "md", "obj", "thorin"};
+        if (!connect.empty()) {
+            // the server has its own Driver: everything that we can't transmit in a server::Request is an error
+            if (os[H] || run || flags.bootstrap || !cache_dir.empty() || manifest_key || parallel_imports
+                || !profile.empty())
+                throw std::invalid_argument("error: --output-h, --run, --bootstrap, --cache, --manifest-key, "
+                                            "--parallel-imports, and --profile are not supported by --connect");
+#ifdef THORIN_ENABLE_CHECKS
+            if (!breakpoints.empty() || flags.reeval_breakpoints || flags.break_on_alpha_unequal
+                || flags.break_on_error || flags.break_on_warn || flags.trace_gids)
+                throw std::invalid_argument("error: developer options are not supported by --connect");
+#endif
+            server::Request req;
+            req.input        = input.empty() ? ""s : fs::absolute(input).string();
+            req.cwd          = fs::current_path();
+            req.opt          = opt;
+            req.verbose      = verbose;
+            req.flags        = flags;
+            req.plugins      = plugins;
+            req.search_paths = search_paths;
+            req.stop         = stop_server;
+            absl::flat_hash_map<std::string, std::ostream*> outputs;
+            for (size_t be = 0; be != Num_Backends; ++be) {
+                if (!os[be]) continue;
+                req.emits.emplace_back(names[be]);
+                outputs[names[be]] = os[be];
+            }
+            auto status = server::request(connect, req, outputs);
+            chmod_exe();
+            return status;
+        }
+
         // we always need standard plugins, as long as we are not in bootstrap mode
         if (!flags.bootstrap) plugins.insert(plugins.end(), {"core", "mem", "compile", "opt"});
 
         if (!plugins.empty())
             for (const auto& plugin : plugins) driver.load(plugin);
 
+        if (!server.empty()) return server::run(driver, plugins, server);
+
         if (input.empty()) throw std::invalid_argument("error: no input given");
         if (input[0] == '-' || input.substr(0, 2) == "--")
             throw std::invalid_argument("error: unknown option " + input);
@@ -131,33 +204,135 @@ int main(int argc, char** argv) {
         auto path = fs::path(input);
         world.set(path.filename().replace_extension().string());
         auto parser = Parser(world);
-        parser.import(input, os[Md]);
 
-        if (flags.bootstrap) {
-            if (auto h = os[H])
-                bootstrap(driver, world.sym(fs::path{path}.filename().replace_extension().string()), *h);
-            opt = std::min(opt, 1);
+        // The pipeline is deterministic: The parsed World, the flags, and the plugins determine the output.
+        std::optional<Cache> cache;
+        std::string key;
+        std::array<std::optional<std::string>, Num_Backends> cached;
+        static const std::array<const char*, Num_Backends> exts = {".c", ".dot", ".exe", ".h", ".ll", ".md", ".o", ".thorin"};
+        if (!cache_dir.empty()) driver.set(&cache.emplace(cache_dir, cache_size * 1024_s * 1024_s));
+
+        auto lookup = [&](Fingerprint& fp) {
+            fp.add(THORIN_VER).add(opt).add(world.name().str());
+            fp.add(flags.dump_gid).add(flags.scalerize_threshold).add(flags.dump_recursive).add(flags.bootstrap);
+            fp.add(flags.aggressive_lam_spec).add(flags.stream_ll).add(flags.instrument).add(flags.loop_hints);
+            fp.add(flags.ll_partitions);
+            if (!profile.empty()) {
+                std::ostringstream counts;
+                counts << std::ifstream(profile).rdbuf();
+                fp.add(counts.str());
+            }
+            for (const auto& plugin : plugins) fp.add(plugin);
+            // at -O2, the pipeline's Thorin code - imported right before optimize - shapes the output, too
+            if (opt == 2) parser.hash_imports(fp, {"opt"});
+            // the plugins' normalizers, passes, and backends as much as their Thorin code
+            for (const auto& file : driver.plugin_files()) fp.add_file(file);
+            key = fp.str();
+            for (auto be : {C, Exe, LL, Obj})
+                if (os[be]) cached[be] = cache->lookup(key + exts[be]);
+        };
+
+        auto done = [&]() {
+            bool res = !os[Thorin] && !os[Dot] && !run;
+            for (auto be : {C, Exe, LL, Obj}) res &= !os[be] || cached[be].has_value();
+            return res;
+        };
+
+        // With --manifest-key, the key stems from the Manifest of the input - which we get without parsing anything.
+        if (manifest_key) {
+            if (!cache) throw std::invalid_argument("error: --manifest-key requires --cache");
+            auto fp = Fingerprint().add(parser.manifest(input).key());
+            lookup(fp);
         }
 
-        switch (opt) {
-            case 0: break;
-            case 1: Phase::run<Cleanup>(world); break;
-            case 2:
-                parser.import("opt");
-                optimize(world);
-                break;
-            default: error("illegal optimization level '{}'", opt);
+        if (!manifest_key || !done() || os[H] || os[Md]) {
+            if (parallel_imports)
+                parser.import_parallel(input, os[Md]);
+            else
+                parser.import(input, os[Md]);
+
+            if (const auto& errors = parser.errors(); !errors.empty()) {
+                for (const auto& err : errors) errln("{}", err);
+                error("aborting due to {} errors", errors.size());
+            }
+
+            if (!profile.empty()) {
+                std::ifstream ifs(profile);
+                if (!ifs) error("cannot read profile '{}'", profile);
+                driver.profile().load(world, ifs, profile);
+            }
+
+            if (flags.bootstrap) {
+                if (auto h = os[H])
+                    bootstrap(driver, world.sym(fs::path{path}.filename().replace_extension().string()), *h);
+                opt = std::min(opt, 1);
+            }
+
+            if (cache && !manifest_key) {
+                auto fp = Fingerprint(world);
+                lookup(fp);
+            }
+        }
+
+        if (!done()) {
+            switch (opt) {
+                case 0: break;
+                case 1: Phase::run<Cleanup>(world); break;
+                case 2:
+                    parser.import("opt");
+                    optimize(world);
+                    break;
+                default: error("illegal optimization level '{}'", opt);
+            }
         }
 
         if (os[Thorin]) world.dump(*os[Thorin]);
         if (os[Dot]) dot::emit(world, *os[Dot]);
 
-        if (os[LL]) {
-            if (auto backend = driver.backend("ll"))
-                backend(world, *os[LL]);
-            else
-                error("'ll' emitter not loaded; try loading 'mem' plugin");
+        auto emit = [&](size_t be, const char* name, const char* hint) {
+            if (!os[be]) return;
+            if (cached[be]) {
+                os[be]->write(cached[be]->data(), cached[be]->size());
+                return;
+            }
+
+            auto backend = driver.backend(name);
+            if (!backend) error("'{}' emitter not loaded; {}", name, hint);
+            if (!cache) return backend(world, *os[be]);
+
+            std::ostringstream oss;
+            backend(world, oss);
+            auto data = oss.str();
+            cache->insert(key + exts[be], data);
+            os[be]->write(data.data(), data.size());
+        };
+
+        emit(C, "c", "try loading 'core' plugin");
+        emit(LL, "ll", "try loading 'mem' plugin");
+        emit(Obj, "obj", "rebuild Thorin with THORIN_ENABLE_LLVM=ON");
+        emit(Exe, "exe", "try loading 'core' plugin");
+
+        chmod_exe();
+
+        int status = EXIT_SUCCESS;
+        if (run) {
+            auto backend = driver.backend("run");
+            if (!backend) error("JIT not available; rebuild Thorin with THORIN_ENABLE_LLVM=ON");
+            std::ostringstream oss;
+            backend(world, oss);
+            auto res       = oss.str();
+            auto [ptr, ec] = std::from_chars(res.data(), res.data() + res.size(), status);
+            if (ec != std::errc() || ptr != res.data() + res.size()) error("JIT yielded no exit code but '{}'", res);
         }
+
+        if (cache) {
+            auto [hits, misses, evictions] = cache->stats();
+            auto total                     = cache->total();
+            world.VLOG("cache {}: {} hits, {} misses, {} evictions (overall: {} hits, {} misses, {} evictions)",
+                       cache->dir().string(), hits, misses, evictions, total.hits, total.misses, total.evictions);
+        }
+
+        return status;
     } catch (const std::exception& e) {
         errln("{}", e.what());
         return EXIT_FAILURE;
@@ -165,6 +340,4 @@ int main(int argc, char** argv) {
         errln("error: unknown exception");
         return EXIT_FAILURE;
     }
-
-    return EXIT_SUCCESS;
 }
@@ -0,0 +1,303 @@
+#include "server.h"
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+
+#include <algorithm>
+#include <iostream>
+#include <optional>
+#include <sstream>
+
+#ifndef _WIN32
+#    include <fcntl.h>
+#    include <sys/socket.h>
+#    include <sys/stat.h>
+#    include <sys/un.h>
+#    include <unistd.h>
+#endif
+
+#include "thorin/be/dot/dot.h"
+#include "thorin/fe/parser.h"
+#include "thorin/pass/optimize.h"
+#include "thorin/phase/phase.h"
+
+using namespace std::literals;
+
+namespace thorin::server {
+
+/*
+ * Protocol:
+ * A Request consists of `<key> <value>` lines and ends with an empty line:
+ * `input <path>`, `cwd <path>`, `opt <level>`, `verbose <level>`, `flag <name> <value>`, `plugin <name>`,
+ * `path <dir>`, `emit <name>`, or `stop <0|1>`. `flag`, `plugin`, `path`, and `emit` are repeatable.
+ * The response consists of `<name> <size>` lines each followed by `<size>` bytes of data - the requested outputs and
+ * the `log` - and ends with `exit <status>`.
+ */
+
+#ifndef _WIN32
+
+namespace {
+
+void send(int fd, std::string_view data) {
+    while (!data.empty()) {
+        auto n = ::write(fd, data.data(), data.size());
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) error("compile server: cannot write to socket: {}", std::strerror(errno));
+        data.remove_prefix(n);
+    }
+}
+
+std::string recv(int fd, size_t size) {
+    std::string data(size, '\0');
+    for (size_t i = 0; i != size;) {
+        auto n = ::read(fd, data.data() + i, size - i);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) error("compile server: connection closed unexpectedly");
+        i += n;
+    }
+    return data;
+}
+
+/// @returns `std::nullopt` upon end of file.
+std::optional<std::string> recv_line(int fd) {
+    std::string line;
+    for (char c;;) {
+        auto n = ::read(fd, &c, 1);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return line.empty() ? std::nullopt : std::optional(line);
+        if (c == '\n') return line;
+        line.push_back(c);
+    }
+}
+
+/// Invokes @p f with name and reference of each Flags member that a Request transmits.
+void for_each_flag(auto& flags, auto f) {
+    f("dump_gid", flags.dump_gid);
+    f("scalerize_threshold", flags.scalerize_threshold);
+    f("ll_partitions", flags.ll_partitions);
+    f("dump_recursive", flags.dump_recursive);
+    f("aggressive_lam_spec", flags.aggressive_lam_spec);
+    f("stream_ll", flags.stream_ll);
+    f("instrument", flags.instrument);
+    f("lazy_imports", flags.lazy_imports);
+    f("recover", flags.recover);
+    f("loop_hints", flags.loop_hints);
+}
+
+std::pair<std::string, std::string> split(const std::string& line) {
+    auto space = line.find(' ');
+    if (space == std::string::npos) error("compile server: malformed line '{}'", line);
+    return {line.substr(0, space), line.substr(space + 1)};
+}
+
+sockaddr_un address(const fs::path& socket) {
+    sockaddr_un addr = {};
+    addr.sun_family  = AF_UNIX;
+    if (socket.native().size() >= sizeof(addr.sun_path)) error("socket path '{}' is too long", socket);
+    std::strcpy(addr.sun_path, socket.c_str());
+    return addr;
+}
+
+Request recv_request(int fd) {
+    Request req;
+    while (auto line = recv_line(fd)) {
+        if (line->empty()) break;
+        auto [key, value] = split(*line);
+        if (key == "input")
+            req.input = value;
+        else if (key == "cwd")
+            req.cwd = value;
+        else if (key == "opt")
+            req.opt = std::stoi(value);
+        else if (key == "verbose")
+            req.verbose = std::stoi(value);
+        else if (key == "flag") {
+            auto [name, val] = split(value);
+            bool found       = false;
+            for_each_flag(req.flags, [&](std::string_view n, auto& flag) {
+                using T = std::remove_reference_t<decltype(flag)>;
+                if (n == name) flag = T(std::stoull(val)), found = true;
+            });
+            if (!found) error("compile server: unknown flag '{}'", name);
+        } else if (key == "plugin")
+            req.plugins.emplace_back(value);
+        else if (key == "path")
+            req.search_paths.emplace_back(value);
+        else if (key == "emit")
+            req.emits.emplace_back(value);
+        else if (key == "stop")
+            req.stop = value == "1";
+        else
+            error("compile server: unknown request '{}'", key);
+    }
+    return req;
+}
+
+/// Runs in a freshly forked child and hence may trash the World.
+int compile(Parser& parser, const Request& req, int fd) {
+    auto& driver = parser.driver();
+    auto& world  = parser.world();
+    auto begin   = std::chrono::steady_clock::now();
+    std::ostringstream log, md;
+    std::vector<std::pair<std::string, std::string>> outputs;
+    int status = EXIT_SUCCESS;
+
+    driver.log().set(&log).set((Log::Level)req.verbose);
+    driver.flags() = req.flags;
+    try {
+        if (req.input.empty()) error("no input given");
+        fs::current_path(req.cwd);
+        for (const auto& path : req.search_paths) driver.add_search_path(path);
+        for (const auto& plugin : req.plugins) parser.plugin(plugin);
+
+        auto path    = fs::path(req.input);
+        bool emit_md = std::ranges::find(req.emits, "md"s) != req.emits.end();
+        world.set(path.filename().replace_extension().string());
+        parser.import(path, emit_md ? &md : nullptr);
+
+        switch (req.opt) {
+            case 0: break;
+            case 1: Phase::run<Cleanup>(world); break;
+            case 2:
+                parser.import("opt");
+                optimize(world);
+                break;
+            default: error("illegal optimization level '{}'", req.opt);
+        }
+
+        for (const auto& name : req.emits) {
+            std::ostringstream oss;
+            if (name == "md")
+                oss << md.str();
+            else if (name == "thorin")
+                world.dump(oss);
+            else if (name == "dot")
+                dot::emit(world, oss);
+            else if (auto backend = driver.backend(name))
+                backend(world, oss);
+            else
+                error("'{}' emitter not loaded", name);
+            outputs.emplace_back(name, std::move(oss).str());
+        }
+    } catch (const std::exception& e) {
+        log << e.what() << std::endl;
+        status = EXIT_FAILURE;
+    }
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+    world.VLOG("compile server: compiled '{}' in {}ms", req.input, ms.count());
+
+    outputs.emplace_back("log", std::move(log).str());
+    for (const auto& [name, data] : outputs) {
+        send(fd, fmt("{} {}\n", name, data.size()));
+        send(fd, data);
+    }
+    send(fd, fmt("exit {}\n", status));
+    return status;
+}
+
+} // namespace
+
+int run(Driver& driver, const std::vector<std::string>& plugins, const fs::path& socket) {
+    auto parser = Parser(driver.world());
+    for (const auto& plugin : plugins)
+        if (plugin != "opt") parser.plugin(plugin);
+
+    auto addr = address(socket);
+    int srv   = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (srv == -1) error("cannot create socket: {}", std::strerror(errno));
+    auto mask  = ::umask(0177); // create the socket with mode 0600 right away - there's no window for others
+    bool bound = ::bind(srv, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != -1;
+    ::umask(mask);
+    if (!bound || ::listen(srv, SOMAXCONN) == -1)
+        error("cannot listen on socket '{}': {}", socket, std::strerror(errno));
+
+    // daemonize: the parent returns as soon as the socket is ready
+    if (auto pid = ::fork(); pid == -1)
+        error("cannot fork compile server: {}", std::strerror(errno));
+    else if (pid != 0)
+        return EXIT_SUCCESS;
+
+    ::setsid();
+    if (int null = ::open("/dev/null", O_RDWR); null != -1) {
+        for (int fd : {STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO}) ::dup2(null, fd);
+        if (null > STDERR_FILENO) ::close(null);
+    }
+    std::signal(SIGCHLD, SIG_IGN); // reap children automatically
+    std::signal(SIGPIPE, SIG_IGN); // a client that hangs up must not take us down
+
+    while (true) {
+        int fd = ::accept(srv, nullptr, nullptr);
+        if (fd == -1) continue;
+
+        // the child receives the Request - a client that is slow to send it mustn't stall this loop
+        if (auto pid = ::fork(); pid == 0) {
+            ::close(srv);
+            int status = EXIT_FAILURE;
+            try {
+                auto req = recv_request(fd);
+                if (req.stop) {
+                    ::unlink(socket.c_str());
+                    ::kill(::getppid(), SIGTERM);
+                    send(fd, "exit 0\n");
+                    ::_exit(EXIT_SUCCESS);
+                }
+                status = compile(parser, req, fd);
+            } catch (...) {} // drop broken requests
+            ::_exit(status); // skip destructors and atexit handlers of the parent's state
+        }
+
+        ::close(fd);
+    }
+}
+
+int request(const fs::path& socket, const Request& req, const absl::flat_hash_map<std::string, std::ostream*>& os) {
+    auto addr = address(socket);
+    int fd    = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1)
+        error("cannot connect to compile server '{}': {}", socket, std::strerror(errno));
+
+    std::ostringstream oss;
+    oss << "input " << req.input << '\n' << "cwd " << req.cwd.string() << '\n';
+    oss << "opt " << req.opt << '\n' << "verbose " << req.verbose << '\n';
+    for_each_flag(req.flags, [&](std::string_view name, auto flag) { print(oss, "flag {} {}\n", name, u64(flag)); });
+    for (const auto& plugin : req.plugins) oss << "plugin " << plugin << '\n';
+    for (const auto& path : req.search_paths) oss << "path " << path << '\n';
+    for (const auto& name : req.emits) oss << "emit " << name << '\n';
+    oss << "stop " << req.stop << "\n\n";
+    send(fd, oss.str());
+
+    int status = EXIT_FAILURE;
+    while (auto line = recv_line(fd)) {
+        auto [key, value] = split(*line);
+        if (key == "exit") {
+            status = std::stoi(value);
+            break;
+        }
+
+        auto data = recv(fd, std::stoull(value));
+        if (key == "log")
+            std::cerr << data;
+        else if (auto i = os.find(key); i != os.end())
+            i->second->write(data.data(), data.size());
+    }
+
+    ::close(fd);
+    return status;
+}
+
+#else
+
+int run(Driver&, const std::vector<std::string>&, const fs::path&) {
+    error("the compile server is not supported on this platform");
+}
+
+int request(const fs::path&, const Request&, const absl::flat_hash_map<std::string, std::ostream*>&) {
+    error("the compile server is not supported on this platform");
+}
+
+#endif
+
+} // namespace thorin::server
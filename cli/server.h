@@ -0,0 +1,41 @@
+#pragma once
+
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "thorin/driver.h"
+
+namespace thorin::server {
+
+namespace fs = std::filesystem;
+
+/// What the client asks the compile server for.
+struct Request {
+    std::string input; ///< Absolute path of the input file.
+    fs::path cwd;      ///< Working directory of the client; relative `.import`s and plugin paths refer to it.
+    int opt     = 2;
+    int verbose = 0;
+    Flags flags;                           ///< Only the options of the command-line utility are transmitted.
+    std::vector<std::string> plugins;      ///< Loaded in addition to the warm plugins of the server.
+    std::vector<std::string> search_paths; ///< See Driver::add_search_path.
+    std::vector<std::string> emits;        ///< Requested outputs: `c`, `dot`, `exe`, `ll`, `md`, `obj`, or `thorin`.
+    bool stop = false;                     ///< Shuts the server down instead.
+};
+
+/// Loads @p plugins into @p driver and parses their Thorin code into its World - except for `opt` which is only needed
+/// for `-O2`.
+/// Then, it forks a daemon that listens on the Unix domain @p socket and returns once the daemon is ready.
+/// Only the owner of the daemon may connect to @p socket.
+/// The daemon forks itself once more for each incoming connection: This child starts from a copy of the warm Driver
+/// and its pristine World, receives and compiles the Request, and sends back the outputs.
+int run(Driver& driver, const std::vector<std::string>& plugins, const fs::path& socket);
+
+/// Sends @p req to the compile server listening on @p socket and writes the received outputs to @p os.
+/// @returns the exit status of the compilation.
+int request(const fs::path& socket, const Request& req, const absl::flat_hash_map<std::string, std::ostream*>& os);
+
+} // namespace thorin::server
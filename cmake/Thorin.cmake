@@ -33,6 +33,8 @@ and passes to identify the axioms.
     the plugin.
     Custom properties can be specified in the using `CMakeLists.txt` file,
     e.g. adding include paths is done with `target_include_directories(thorin_<name> <path>..)`.
+    Use the keyword signature (`PUBLIC`/`PRIVATE`) when calling `target_link_libraries` on `thorin_<name>` or
+    `thorin_<name>_static`.
 - `DEPENDS`: The `DEPENDS` arguments specify the relation between multiple
     plugins. This makes sure that the bootstrapping of the plugin is done
     whenever a depended-upon plugin description is changed.
@@ -48,6 +50,13 @@ and passes to identify the axioms.
     To export the targets, the export name `thorin-targets` has to be
     exported accordingly (see [install(EXPORT ..)](https://cmake.org/cmake/help/latest/command/install.html#export))
 
+If `<name>` is listed in `THORIN_STATIC_PLUGINS`, `add_thorin_plugin` additionally
+creates an object library `thorin_<name>_static` that is linked into the
+`thorin-static` executable. There, its `thorin_get_plugin` is renamed to
+`thorin_get_plugin_<name>` and registered via `thorin::register_static_plugin`.
+Plugins that share source files (like `autodiff` and `compile`) cannot be linked
+statically at the same time.
+
 
 ## Note: a copy of this text is in `docs/coding.md`. Please update!
 #]=======================================================================]
@@ -123,7 +132,7 @@ function(add_thorin_plugin)
             LIBRARY_OUTPUT_DIRECTORY ${THORIN_LIB_DIR}
     )
 
-    target_link_libraries(thorin_${PLUGIN} ${THORIN_TARGET_NAMESPACE}libthorin)
+    target_link_libraries(thorin_${PLUGIN} PUBLIC ${THORIN_TARGET_NAMESPACE}libthorin)
 
     target_include_directories(thorin_${PLUGIN}
         PUBLIC
@@ -152,6 +161,18 @@ function(add_thorin_plugin)
             DESTINATION include/dialects
             FILES_MATCHING PATTERN *.h)
     endif()
+    if(${PLUGIN} IN_LIST THORIN_STATIC_PLUGINS)
+        add_library(thorin_${PLUGIN}_static
+            OBJECT
+                ${PARSED_SOURCES}
+                ${PLUGIN_H}
+                ${DEPENDS_HEADER_FILES}
+        )
+        add_dependencies(thorin_${PLUGIN}_static ${PLUGIN} ${PARSED_DEPENDS} ${PARSED_HEADER_DEPENDS})
+        target_compile_definitions(thorin_${PLUGIN}_static PRIVATE thorin_get_plugin=thorin_get_plugin_${PLUGIN})
+        target_link_libraries(thorin_${PLUGIN}_static PUBLIC ${THORIN_TARGET_NAMESPACE}libthorin)
+        target_include_directories(thorin_${PLUGIN}_static PUBLIC $<BUILD_INTERFACE:${CMAKE_BINARY_DIR}/include>)
+    endif()
     if(TARGET thorin_all_plugins)
         add_dependencies(thorin_all_plugins thorin_${PLUGIN})
     endif()
@@ -12,5 +12,5 @@ using namespace thorin;
 
 extern "C" THORIN_EXPORT Plugin thorin_get_plugin() {
     return {"affine", nullptr, [](Passes& passes) { register_pass<affine::lower_for_pass, affine::LowerFor>(passes); },
-            nullptr};
+            nullptr, nullptr};
 }
@@ -21,7 +21,7 @@ extern "C" THORIN_EXPORT Plugin thorin_get_plugin() {
                 register_pass<autodiff::ad_zero_cleanup_pass, autodiff::AutoDiffZeroCleanup>(passes);
                 register_pass<autodiff::ad_ext_cleanup_pass, compile::InternalCleanup>(passes, "internal_diff_");
             },
-            nullptr};
+            nullptr, nullptr};
 }
 
 namespace thorin::autodiff {
@@ -0,0 +1,42 @@
+#include "dialects/clos/be/ll.h"
+
+#include <thorin/be/ll/lowerer.h>
+
+#include "dialects/clos/clos.h"
+
+namespace thorin::clos {
+
+namespace {
+
+template<class Id> std::string lower(ll::Lowerer&, const Def*, const std::string& name);
+
+template<> std::string lower<clos::alloc_jmpbuf>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto q = force<clos::alloc_jmpbuf>(def);
+    be.declare("i64 @jmpbuf_size()");
+
+    be.emit_unsafe(q->arg());
+    auto size = name + ".size";
+    be.assign(size, "call i64 @jmpbuf_size()");
+    return be.assign(name, "alloca i8, i64 {}", size);
+}
+
+template<> std::string lower<clos::setjmp>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto setjmp = force<clos::setjmp>(def);
+    be.declare("i32 @_setjmp(i8*) returns_twice");
+
+    auto [mem, jmpbuf] = setjmp->arg()->projs<2>();
+    be.emit_unsafe(mem);
+    auto v_jb = be.emit(jmpbuf);
+    return be.assign(name, "call i32 @_setjmp(i8* {})", v_jb);
+}
+
+template<class... Ids> void add(Lowerings& lowerings) {
+    (assert_emplace(lowerings, Annex::Base<Ids>, &lower<Ids>), ...);
+}
+
+} // namespace
+
+// %clos.longjmp is a jump rather than an instruction; the LLVM backend handles it directly.
+void register_lowerings(Lowerings& lowerings) { add<clos::alloc_jmpbuf, clos::setjmp>(lowerings); }
+
+} // namespace thorin::clos
@@ -7,6 +7,7 @@
 #include <thorin/pass/pipelinebuilder.h>
 #include <thorin/pass/rw/scalarize.h>
 
+#include "dialects/clos/be/ll.h"
 #include "dialects/clos/pass/fp/lower_typed_clos_prep.h"
 #include "dialects/clos/pass/rw/branch_clos_elim.h"
 #include "dialects/clos/pass/rw/clos2sjlj.h"
@@ -32,7 +33,7 @@ extern "C" THORIN_EXPORT Plugin thorin_get_plugin() {
                     builder.add_pass<EtaRed>(app, bb_only);
                 };
             },
-            nullptr};
+            nullptr, [](Lowerings& lowerings) { clos::register_lowerings(lowerings); }};
 }
 
 namespace thorin::clos {
@@ -80,5 +80,5 @@ extern "C" THORIN_EXPORT thorin::Plugin thorin_get_plugin() {
                 register_pass_with_arg<compile::scalerize_pass, Scalerize, EtaExp>(passes);
                 register_pass_with_arg<compile::tail_rec_elim_pass, TailRecElim, EtaRed>(passes);
             },
-            nullptr};
+            nullptr, nullptr};
 }
@@ -0,0 +1,1102 @@
+#include "dialects/core/be/c.h"
+
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <deque>
+
+#include "thorin/be/emitter.h"
+#include "thorin/util/print.h"
+
+#include "dialects/clos/clos.h"
+#include "dialects/core/be/helper.h"
+#include "dialects/core/core.h"
+#include "dialects/math/math.h"
+#include "dialects/mem/mem.h"
+
+// Differences to the LLVM backend:
+// * C's integer types carry a signedness. We use the unsigned ones throughout and cast wherever Thorin asks for
+//   signed semantics.
+// * Integer promotion turns, e.g., `uint16_t * uint16_t` into an `int` multiplication that may overflow.
+//   Hence, wrapping arithmetic on less than 32 bits is performed on `uint32_t` and truncated afterwards.
+// * Arrays are no values in C. So, an Arr becomes a `struct` with a single array member `e`.
+// * A label must precede a statement - not a declaration. Thus, all locals are declared at the top of a function.
+using namespace std::string_literals;
+
+namespace thorin::c {
+
+namespace {
+
+/// Yields the bitwidth of @p type, if it is a Nat or an Idx.
+std::optional<nat_t> isa_int(const Def* type) {
+    if (type->isa<Nat>()) return 64;
+    if (auto size = Idx::size(type)) return Idx::size2bitwidth(size);
+    return {};
+}
+
+/// Smallest fixed-width integer type that holds @p w bits.
+std::string int_t(nat_t w, bool is_signed = false) {
+    auto n = w <= 8 ? 8 : w <= 16 ? 16 : w <= 32 ? 32 : 64;
+    return fmt("{}int{}_t", is_signed ? "" : "u", n);
+}
+
+/// Casts @p expr to @p t after cutting it down to @p w bits - unless the cast does this anyway.
+std::string trunc(std::string_view t, nat_t w, std::string_view expr) {
+    if (w == 8 || w == 16 || w == 32 || w == 64) return fmt("(({})({}))", t, expr);
+    return fmt("(({})(({}) & {}u))", t, expr, (u64(1) << w) - 1);
+}
+
+/// Reinterprets @p x - an unsigned value of @p w bits - as signed.
+/// Unless the cast does this anyway, the sign bit `w-1` is extended first: `(x ^ m) - m` with `m = 1 << (w-1)`.
+std::string sext(nat_t w, std::string_view x) {
+    auto s = int_t(w, true);
+    if (w == 8 || w == 16 || w == 32 || w == 64) return fmt("(({}){})", s, x);
+    auto m = u64(1) << (w - 1);
+    return fmt("(({})(({} ^ {}u) - {}u))", s, x, m, m);
+}
+
+/// Avoids integer promotion to `int` for operands of less than 32 bits.
+std::string widen(nat_t w, std::string_view x) { return w < 32 ? fmt("(uint32_t){}", x) : std::string(x); }
+
+std::string sanitize(std::string s) {
+    for (auto& c : s)
+        if (!std::isalnum(static_cast<unsigned char>(c))) c = '_';
+    return s;
+}
+
+} // namespace
+
+struct BB {
+    BB()                               = default;
+    BB(const BB&)                      = delete;
+    BB(BB&& other) noexcept            = default;
+    BB& operator=(BB&& other) noexcept = default;
+
+    std::deque<std::string>& body() { return parts[0]; }
+    std::deque<std::string>& tail() { return parts[1]; }
+
+    template<class... Args> void body(const char* s, Args&&... args) {
+        body().emplace_back(fmt(s, std::forward<Args&&>(args)...));
+    }
+
+    template<class... Args> void tail(const char* s, Args&&... args) {
+        tail().emplace_back(fmt(s, std::forward<Args&&>(args)...));
+    }
+
+    std::array<std::deque<std::string>, 2> parts;
+};
+
+class Emitter : public thorin::Emitter<std::string, std::string, BB, Emitter> {
+public:
+    using Super = thorin::Emitter<std::string, std::string, BB, Emitter>;
+
+    Emitter(World& world, std::ostream& ostream)
+        : Super(world, "c_emitter", ostream) {}
+
+    bool is_valid(std::string_view s) { return !s.empty(); }
+    void start() override;
+    void emit_imported(Lam*);
+    void emit_epilogue(Lam*);
+    std::string emit_bb(BB&, const Def*);
+    std::string prepare(const Scope&);
+    void finalize(const Scope&);
+
+private:
+    std::string id(const Def*) const;
+    std::string convert(const Def*);
+    std::string convert_ret_pi(const Pi*);
+    std::string params(const Pi*);
+    std::string zero(const Def* type);
+    std::string initializer(const Def*);
+    void include(const char* header) { includes_.emplace(header); }
+
+    /// Declares @p name of @p type at the top of the current function.
+    std::string local(std::string_view type, const std::string& name) {
+        decls_.emplace_back(fmt("{} {};", type, name));
+        return name;
+    }
+
+    template<class... Args>
+    std::string assign(BB& bb, const Def* type, const std::string& name, const char* s, Args&&... args) {
+        local(convert(type), name);
+        bb.body().emplace_back(fmt("{} = ", name) + fmt(s, std::forward<Args&&>(args)...) + ";");
+        return name;
+    }
+
+    std::string emit_tuple(BB&, const Def*, const std::string& name);
+    std::string emit_jump(Lam* callee, const App* app);
+    std::string binop(Ref f, const Def* type, std::string_view a, std::string_view b);
+
+    /// @name Lowerings
+    /// Same scheme as in the LLVM backend: Fully applied Axiom%s are dispatched via Annex::flags2base.
+    ///@{
+    using Lowering  = std::string (Emitter::*)(BB&, const Def*, const std::string& name);
+    using Lowerings = absl::flat_hash_map<flags_t, Lowering>;
+
+    template<class Id> std::string lower(BB&, const Def*, const std::string& name);
+    template<class... Ids> static void add(Lowerings& lowerings) {
+        (lowerings.emplace(Annex::Base<Ids>, &Emitter::lower<Ids>), ...);
+    }
+    static const Lowerings& lowerings();
+    ///@}
+
+    Lam* main_ = nullptr;
+    absl::btree_set<std::string> includes_;
+    std::vector<std::string> decls_; ///< Locals of the current function.
+    std::ostringstream type_decls_;
+    std::ostringstream vars_decls_;
+    std::ostringstream func_decls_;
+    std::ostringstream func_impls_;
+};
+
+/*
+ * convert
+ */
+
+std::string Emitter::id(const Def* def) const {
+    if (auto lam = def->isa_mut<Lam>(); lam && lam->type()->ret_pi() && (lam->is_external() || !lam->is_set())) {
+        // the actual main is a wrapper with the signature C demands - see Emitter::start
+        std::string name = lam->sym().str();
+        return name == "main" ? "thorin_main"s : name;
+    }
+
+    return sanitize(def->unique_name());
+}
+
+std::string Emitter::convert(const Def* type) {
+    if (auto i = types_.find(type); i != types_.end()) return i->second;
+
+    assert(!match<mem::M>(type));
+    if (auto w = isa_int(type)) return types_[type] = *w == 1 ? "bool"s : int_t(*w);
+
+    if (auto w = math::isa_f(type)) {
+        switch (*w) {
+            case 32: return types_[type] = "float";
+            case 64: return types_[type] = "double";
+            default: error("C backend doesn't support {}-bit floating point numbers", *w);
+        }
+    }
+
+    if (auto ptr = match<mem::Ptr>(type)) {
+        auto [pointee, addr_space] = ptr->args<2>();
+        // a pointer to an array of unknown size points to its first element
+        if (auto arr = pointee->isa<Arr>(); arr && !Lit::isa(arr->shape()))
+            return types_[type] = convert(arr->body()) + "*";
+        return types_[type] = convert(pointee) + "*";
+    }
+
+    if (auto t = core::isa_mem_sigma_2(type)) return types_[type] = convert(t);
+
+    auto name = fmt("t_{}", type->gid());
+    if (auto arr = type->isa<Arr>()) {
+        auto size = Lit::isa(arr->shape());
+        if (!size) error("C backend can't pass array of unknown size '{}' by value", type);
+        auto t_elem = convert(arr->body());
+        print(type_decls_, "typedef struct {{ {} e[{}]; }} {};\n", t_elem, *size, name);
+    } else if (auto pi = type->isa<Pi>()) {
+        assert(Pi::isa_returning(pi) && "should never have to convert type of BB");
+        auto t_ret = convert_ret_pi(pi->ret_pi());
+        auto ps    = params(pi);
+        print(type_decls_, "typedef {} (*{})({});\n", t_ret, name, ps);
+    } else if (auto sigma = type->isa<Sigma>()) {
+        // declare first as a mutable Sigma may refer to itself
+        print(type_decls_, "typedef struct {} {};\n", name, name);
+        types_[type] = name;
+
+        std::ostringstream s;
+        print(s, "struct {} {{", name);
+        size_t i = 0;
+        for (auto t : sigma->ops()) {
+            if (match<mem::M>(t)) continue;
+            print(s, " {} e{};", convert(t), i++);
+        }
+        if (i == 0) s << " char unit;"; // C forbids empty structs
+        print(s, " }};\n");
+        type_decls_ << s.str();
+    } else {
+        fe::unreachable();
+    }
+
+    return types_[type] = name;
+}
+
+std::string Emitter::convert_ret_pi(const Pi* pi) {
+    auto dom = mem::strip_mem_ty(pi->dom());
+    if (dom == world().sigma()) return "void";
+    return convert(dom);
+}
+
+std::string Emitter::params(const Pi* pi) {
+    std::vector<std::string> ts;
+    auto doms = pi->doms();
+    for (auto dom : doms.view().rsubspan(1))
+        if (!match<mem::M>(dom)) ts.emplace_back(convert(dom));
+    return ts.empty() ? "void"s : fmt("{, }", ts);
+}
+
+std::string Emitter::zero(const Def* type) {
+    auto t = convert(type);
+    if (type->isa<Arr>() || (type->isa<Sigma>() && !core::isa_mem_sigma_2(type))) return fmt("(({}){{0}})", t);
+    return fmt("(({})0)", t);
+}
+
+/// Variables with static storage duration must be initialized with constant expressions - so no compound literals.
+std::string Emitter::initializer(const Def* def) {
+    if (def->isa<Bot>()) return "{0}";
+    if (def->isa<Lit>()) return emit(def);
+
+    if (def->isa<Tuple>() || def->isa<Pack>()) {
+        std::vector<std::string> elems;
+        for (size_t i = 0, n = def->num_projs(); i != n; ++i) elems.emplace_back(initializer(def->proj(n, i)));
+        return def->type()->isa<Arr>() ? fmt("{{ {{ {, } }} }}", elems) : fmt("{{ {, } }}", elems);
+    }
+
+    error("C backend can only initialize globals with constants but got '{}'", def);
+}
+
+/*
+ * emit
+ */
+
+void Emitter::start() {
+    auto begin = std::chrono::steady_clock::now();
+    Super::start();
+
+    ostream() << "#include <stdbool.h>\n";
+    ostream() << "#include <stdint.h>\n";
+    for (auto&& header : includes_) print(ostream(), "#include <{}>\n", header);
+    ostream() << '\n' << type_decls_.str() << '\n';
+    ostream() << func_decls_.str() << '\n';
+    ostream() << vars_decls_.str() << '\n';
+    ostream() << func_impls_.str();
+
+    if (main_) {
+        // C insists on int main(int, char**) while Thorin's main usually deals with %core.I32
+        std::vector<std::string> args;
+        auto vars = main_->vars();
+        for (size_t i = 0, n = vars.size() - 1; i != n; ++i) {
+            if (match<mem::M>(vars[i]->type())) continue;
+            if (args.size() == 2) error("'main' may at most expect 'argc' and 'argv': {}", main_->type());
+            args.emplace_back(fmt("({}){}", convert(vars[i]->type()), args.empty() ? "argc" : "argv"));
+        }
+
+        ostream() << "int main(int argc, char** argv) {\n";
+        if (convert_ret_pi(main_->type()->ret_pi()) == "void")
+            print(ostream(), "    thorin_main({, });\n    return 0;\n", args);
+        else
+            print(ostream(), "    return (int)thorin_main({, });\n", args);
+        ostream() << "}\n";
+    }
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+    world().VLOG("emitted C in {}ms", ms.count());
+}
+
+void Emitter::emit_imported(Lam* lam) {
+    print(func_decls_, "{} {}({});\n", convert_ret_pi(lam->type()->ret_pi()), id(lam), params(lam->type()));
+}
+
+std::string Emitter::prepare(const Scope& scope) {
+    auto lam = scope.entry()->as_mut<Lam>();
+    if (id(lam) == "thorin_main") main_ = lam;
+
+    std::vector<std::string> params;
+    auto vars = lam->vars();
+    for (size_t i = 0, n = vars.size() - 1; i != n; ++i) {
+        auto var = vars[i];
+        if (match<mem::M>(var->type())) continue;
+        auto name    = id(var);
+        locals_[var] = name;
+        params.emplace_back(convert(var->type()) + " " + name);
+    }
+
+    auto linkage = lam->is_external() ? "" : "static ";
+    auto t_ret   = convert_ret_pi(lam->type()->ret_pi());
+    auto ps      = params.empty() ? "void"s : fmt("{, }", params);
+    print(func_decls_, "{}{} {}({});\n", linkage, t_ret, id(lam), ps);
+    print(func_impls_, "{}{} {}({}) {{\n", linkage, t_ret, id(lam), ps);
+
+    // the Var%s of basic blocks are locals which the predecessors assign to before jumping
+    for (auto mut : Scheduler::schedule(scope)) {
+        if (auto bb = mut->isa_mut<Lam>(); bb && bb != lam && bb != scope.exit()) {
+            for (size_t i = 0, n = bb->num_tvars(); i != n; ++i) {
+                auto var = bb->var(n, i);
+                if (!match<mem::M>(var->type())) locals_[var] = local(convert(var->type()), id(var));
+            }
+        }
+    }
+
+    return lam->unique_name();
+}
+
+void Emitter::finalize(const Scope& scope) {
+    auto& os = func_impls_;
+
+    ++tab;
+    for (const auto& decl : decls_) tab.print(os, "{}\n", decl);
+    --tab;
+
+    for (auto mut : Scheduler::schedule(scope)) {
+        if (auto lam = mut->isa_mut<Lam>()) {
+            if (lam == scope.exit()) continue;
+            assert(lam2bb_.contains(lam));
+            auto& bb = lam2bb_[lam];
+
+            if (lam != entry_) print(os, "{}:\n", id(lam));
+            ++tab;
+            for (const auto& part : bb.parts)
+                for (const auto& line : part) tab.print(os, "{}\n", line);
+            --tab;
+
+            bb = BB(); // free memory - we won't need this BB anymore
+        }
+    }
+
+    print(os, "}}\n\n");
+    decls_.clear();
+}
+
+/// Passes the arguments of @p app to the Var%s of @p callee and jumps there.
+/// As @p app may permute the Var%s - think of `loop (mem, j, i)` - all arguments are read before any Var is written.
+std::string Emitter::emit_jump(Lam* callee, const App* app) {
+    assert(callee->num_tvars() == app->num_targs());
+    std::vector<std::pair<const Def*, std::string>> moves;
+    for (size_t i = 0, n = callee->num_tvars(); i != n; ++i) {
+        if (auto arg = emit_unsafe(app->arg(n, i)); !arg.empty()) {
+            auto phi = callee->var(n, i);
+            assert(!match<mem::M>(phi->type()));
+            moves.emplace_back(phi, arg);
+        }
+    }
+
+    auto label = id(callee);
+    if (moves.empty()) return fmt("goto {};", label);
+    if (moves.size() == 1) return fmt("{{ {} = {}; goto {}; }}", id(moves[0].first), moves[0].second, label);
+
+    std::ostringstream s;
+    s << "{ ";
+    for (size_t i = 0, n = moves.size(); i != n; ++i)
+        print(s, "{} _t{} = {}; ", convert(moves[i].first->type()), i, moves[i].second);
+    for (size_t i = 0, n = moves.size(); i != n; ++i) print(s, "{} = _t{}; ", id(moves[i].first), i);
+    print(s, "goto {}; }}", label);
+    return s.str();
+}
+
+void Emitter::emit_epilogue(Lam* lam) {
+    auto app = lam->body()->as<App>();
+    auto& bb = lam2bb_[lam];
+
+    if (app->callee() == entry_->ret_var()) { // return
+        std::vector<std::string> values;
+        std::vector<const Def*> types;
+
+        for (auto arg : app->args()) {
+            if (auto val = emit_unsafe(arg); !val.empty()) {
+                values.emplace_back(val);
+                types.emplace_back(arg->type());
+            }
+        }
+
+        switch (values.size()) {
+            case 0: return bb.tail("return;");
+            case 1: return bb.tail("return {};", values[0]);
+            default: return bb.tail("return ({}){{{, }}};", convert(world().sigma(types)), values);
+        }
+    } else if (auto ex = app->callee()->isa<Extract>(); ex && Pi::isa_basicblock(app->callee_type())) {
+        // A call to an extract like constructed for conditionals (else,then)#cond (args)
+        std::vector<std::string> jumps;
+        for (auto callee : ex->tuple()->projs()) jumps.emplace_back(emit_jump(callee->as_mut<Lam>(), app));
+
+        auto c = emit(ex->index());
+        if (jumps.size() == 2) return bb.tail("if ({}) {} else {}", c, jumps[1], jumps[0]);
+
+        bb.tail("switch ({}) {{", c);
+        for (size_t i = 0, n = jumps.size(); i != n; ++i) {
+            if (i + 1 == n)
+                bb.tail("    default: {}", jumps[i]);
+            else
+                bb.tail("    case {}: {}", i, jumps[i]);
+        }
+        return bb.tail("}}");
+    } else if (app->callee()->isa<Bot>()) {
+        include("stdlib.h");
+        return bb.tail("abort(); // bottom: unreachable");
+    } else if (auto callee = Lam::isa_mut_basicblock(app->callee())) { // ordinary jump
+        return bb.tail("{}", emit_jump(callee, app));
+    } else if (auto longjmp = match<clos::longjmp>(app)) {
+        include("setjmp.h");
+
+        auto [mem, jbuf, tag] = app->args<3>();
+        emit_unsafe(mem);
+        auto v_jb  = emit(jbuf);
+        auto v_tag = emit(tag);
+        return bb.tail("longjmp(*(jmp_buf*){}, {});", v_jb, v_tag);
+    } else if (Pi::isa_returning(app->callee_type())) { // function call
+        auto v_callee = emit(app->callee());
+
+        std::vector<std::string> args;
+        auto app_args = app->args();
+        for (auto arg : app_args.view().rsubspan(1))
+            if (auto v_arg = emit_unsafe(arg); !v_arg.empty()) args.emplace_back(v_arg);
+
+        if (app->args().back()->isa<Bot>()) {
+            include("stdlib.h");
+            bb.tail("{}({, });", v_callee, args);
+            return bb.tail("abort(); // bottom: unreachable");
+        }
+
+        auto ret_lam = app->args().back()->as_mut<Lam>();
+        auto t_ret   = convert_ret_pi(ret_lam->type());
+        if (t_ret == "void") {
+            bb.tail("{}({, });", v_callee, args);
+        } else {
+            auto name = local(t_ret, id(app) + "_ret");
+            bb.tail("{} = {}({, });", name, v_callee, args);
+
+            std::vector<const Def*> phis;
+            for (size_t i = 0, n = ret_lam->num_tvars(); i != n; ++i)
+                if (auto phi = ret_lam->var(n, i); !match<mem::M>(phi->type())) phis.emplace_back(phi);
+
+            for (size_t i = 0, n = phis.size(); i != n; ++i)
+                bb.tail("{} = {}{};", id(phis[i]), name, n == 1 ? ""s : fmt(".e{}", i));
+        }
+
+        return bb.tail("goto {};", id(ret_lam));
+    }
+}
+
+std::string Emitter::emit_tuple(BB& bb, const Def* tuple, const std::string& name) {
+    if (core::isa_mem_sigma_2(tuple->type())) {
+        emit_unsafe(tuple->proj(2, 0));
+        return emit(tuple->proj(2, 1));
+    }
+
+    std::vector<std::string> elems;
+    for (size_t i = 0, n = tuple->num_projs(); i != n; ++i)
+        if (auto elem = emit_unsafe(tuple->proj(n, i)); !elem.empty()) elems.emplace_back(elem);
+    if (elems.empty()) return {};
+
+    auto t    = convert(tuple->type());
+    auto init = tuple->type()->isa<Arr>() ? fmt("{{{{{, }}}}}", elems) : fmt("{{{, }}}", elems);
+    if (core::is_const(tuple)) return fmt("(({}){})", t, init);
+    return assign(bb, tuple->type(), name, "({}){}", t, init);
+}
+
+std::string Emitter::emit_bb(BB& bb, const Def* def) {
+    if (auto lam = def->isa<Lam>()) return id(lam);
+
+    auto name = id(def);
+
+    if (auto [axiom, curry, _] = Axiom::get(def); axiom && curry == 0) {
+        auto& lowerings = Emitter::lowerings();
+        if (auto i = lowerings.find(axiom->base()); i != lowerings.end()) return (this->*(i->second))(bb, def, name);
+        error("unhandled def in C backend: {} : {}", def, def->type());
+    }
+
+    switch (def->node()) {
+        case Node::Var: {
+            auto ts = def->type()->projs();
+            if (std::ranges::any_of(ts, [](auto t) { return match<mem::M>(t); })) return {};
+            return emit_tuple(bb, def, name);
+        }
+        case Node::Lit: {
+            auto lit = def->as<Lit>();
+            auto t   = convert(lit->type());
+            if (auto w = isa_int(lit->type()))
+                return *w == 64 ? fmt("UINT64_C({})", lit->get()) : fmt("(({}){})", t, lit->get());
+
+            auto f = *math::isa_f(lit->type()) == 32 ? f64(lit->get<f32>()) : lit->get<f64>();
+            if (std::isnan(f) || std::isinf(f)) {
+                include("math.h");
+                return fmt("(({}){})", t, std::isnan(f) ? "NAN" : f < 0 ? "-INFINITY" : "INFINITY");
+            }
+
+            // hexadecimal floating-point literals are exact
+            std::ostringstream s;
+            s << '(' << std::hexfloat << f << (t == "float" ? "f" : "") << ')';
+            return s.str();
+        }
+        case Node::Bot:
+            if (match<mem::M>(def->type())) return {};
+            return zero(def->type());
+        case Node::Top:
+            if (match<mem::M>(def->type())) return {};
+            break; // bail out to error below
+        case Node::Tuple: return emit_tuple(bb, def, name);
+        case Node::Pack: {
+            auto pack = def->as<Pack>();
+            if (auto lit = Lit::isa(pack->body()); lit && *lit == 0) return zero(pack->type());
+
+            auto v_elem = emit(pack->body());
+            local(convert(pack->type()), name);
+            bb.body("for (uint64_t i = 0; i != {}; ++i) {}.e[i] = {};", Lit::as(pack->shape()), name, v_elem);
+            return name;
+        }
+        case Node::Extract: {
+            auto extract = def->as<Extract>();
+            auto tuple   = extract->tuple();
+            auto index   = extract->index();
+            auto v_tup   = emit_unsafe(tuple);
+
+            // this exact location is important: after emitting the tuple -> ordering of mem ops
+            // before emitting the index, as it might be a weird value for mem vars.
+            if (match<mem::M>(extract->type())) return {};
+            if (core::isa_mem_sigma_2(tuple->type())) return v_tup;
+
+            // unlike LLVM's extractvalue, C is fine with dynamic array indices
+            if (tuple->type()->isa<Arr>()) return assign(bb, extract->type(), name, "{}.e[{}]", v_tup, emit(index));
+
+            // Adjust index, if mem is present.
+            auto i = Lit::as(index);
+            if (match<mem::M>(tuple->proj(0)->type())) --i;
+            return assign(bb, extract->type(), name, "{}.e{}", v_tup, i);
+        }
+        case Node::Insert: {
+            auto insert = def->as<Insert>();
+            assert(!match<mem::M>(insert->tuple()->proj(0)->type()));
+            auto v_tup = emit(insert->tuple());
+            auto v_val = emit(insert->value());
+            assign(bb, insert->type(), name, "{}", v_tup);
+
+            if (insert->tuple()->type()->isa<Arr>())
+                bb.body("{}.e[{}] = {};", name, emit(insert->index()), v_val);
+            else
+                bb.body("{}.e{} = {};", name, Lit::as(insert->index()), v_val);
+            return name;
+        }
+        case Node::Global: {
+            auto global                = def->as<Global>();
+            auto [pointee, addr_space] = force<mem::Ptr>(global->type())->args<2>();
+            print(vars_decls_, "static {} {} = {};\n", convert(pointee), name, initializer(global->init()));
+            return globals_[global] = "(&" + name + ")";
+        }
+        default: break;
+    }
+
+    error("unhandled def in C backend: {} : {}", def, def->type());
+}
+
+/// Yields the C expression for `f (a, b)`, if @p f is an element-wise binary operation on @p type.
+/// @returns the empty string otherwise.
+std::string Emitter::binop(Ref f, const Def* type, std::string_view a, std::string_view b) {
+    auto [axiom, curry, _] = Axiom::get(f);
+    if (!axiom || curry != 1) return {};
+
+    auto t = convert(type);
+    switch (axiom->base()) {
+        case Annex::Base<core::wrap>: {
+            auto w = *isa_int(type);
+            const char* op;
+            switch (core::wrap(axiom->flags())) {
+                case core::wrap::add: op = "+"; break;
+                case core::wrap::sub: op = "-"; break;
+                case core::wrap::mul: op = "*"; break;
+                case core::wrap::shl: op = "<<"; break;
+                default: fe::unreachable();
+            }
+            return trunc(t, w, fmt("{} {} {}", widen(w, a), op, widen(w, b)));
+        }
+        case Annex::Base<core::shr>:
+            if (core::shr(axiom->flags()) == core::shr::a)
+                return trunc(t, *isa_int(type), fmt("{} >> {}", sext(*isa_int(type), a), b));
+            return fmt("({} >> {})", a, b);
+        case Annex::Base<math::arith>:
+            switch (math::arith(axiom->flags())) {
+                case math::arith::add: return fmt("({} + {})", a, b);
+                case math::arith::sub: return fmt("({} - {})", a, b);
+                case math::arith::mul: return fmt("({} * {})", a, b);
+                case math::arith::div: return fmt("({} / {})", a, b);
+                case math::arith::rem: {
+                    include("math.h");
+                    return fmt("fmod{}({}, {})", core::math_suffix(type), a, b);
+                }
+                default: fe::unreachable();
+            }
+        default: return {};
+    }
+}
+
+/*
+ * lowerings
+ */
+
+template<> std::string Emitter::lower<core::nat>(BB& bb, const Def* def, const std::string& name) {
+    auto nat = force<core::nat>(def);
+    const char* op;
+    auto [a, b] = nat->args<2>([this](auto def) { return emit(def); });
+
+    switch (nat.id()) {
+        case core::nat::add: op = "+"; break;
+        case core::nat::sub: op = "-"; break;
+        case core::nat::mul: op = "*"; break;
+        default: fe::unreachable();
+    }
+
+    return assign(bb, def->type(), name, "{} {} {}", a, op, b);
+}
+
+template<> std::string Emitter::lower<core::ncmp>(BB& bb, const Def* def, const std::string& name) {
+    auto ncmp = force<core::ncmp>(def);
+    const char* op;
+    auto [a, b] = ncmp->args<2>([this](auto def) { return emit(def); });
+
+    switch (ncmp.id()) {
+        // clang-format off
+        case core::ncmp::e:  op = "=="; break;
+        case core::ncmp::ne: op = "!="; break;
+        case core::ncmp::g:  op = ">" ; break;
+        case core::ncmp::ge: op = ">="; break;
+        case core::ncmp::l:  op = "<" ; break;
+        case core::ncmp::le: op = "<="; break;
+        // clang-format on
+        default: fe::unreachable();
+    }
+
+    return assign(bb, def->type(), name, "{} {} {}", a, op, b);
+}
+
+template<> std::string Emitter::lower<core::idx>(BB& bb, const Def* def, const std::string& name) {
+    auto idx = force<core::idx>(def);
+    auto x   = emit(idx->arg());
+    return assign(bb, def->type(), name, "{}", trunc(convert(def->type()), *isa_int(def->type()), x));
+}
+
+template<> std::string Emitter::lower<core::bit1>(BB& bb, const Def* def, const std::string& name) {
+    auto bit1 = force<core::bit1>(def);
+    assert(bit1.id() == core::bit1::neg);
+    auto x = emit(bit1->arg());
+    auto w = *isa_int(def->type());
+    if (w == 1) return assign(bb, def->type(), name, "!{}", x);
+    return assign(bb, def->type(), name, "{}", trunc(convert(def->type()), w, "~" + x));
+}
+
+template<> std::string Emitter::lower<core::bit2>(BB& bb, const Def* def, const std::string& name) {
+    auto bit2   = force<core::bit2>(def);
+    auto [a, b] = bit2->args<2>([this](auto def) { return emit(def); });
+    auto t      = convert(def->type());
+    auto w      = *isa_int(def->type());
+
+    auto op  = [&](const char* op, std::string_view x, std::string_view y) {
+        return trunc(t, w, fmt("{} {} {}", x, op, y));
+    };
+    auto neg = [&](std::string_view x) { return w == 1 ? fmt("(!{})", x) : trunc(t, w, fmt("~{}", x)); };
+
+    std::string res;
+    switch (bit2.id()) {
+        // clang-format off
+        case core::bit2::and_: res =     op("&", a, b) ; break;
+        case core::bit2:: or_: res =     op("|", a, b) ; break;
+        case core::bit2::xor_: res =     op("^", a, b) ; break;
+        case core::bit2::nand: res = neg(op("&", a, b)); break;
+        case core::bit2:: nor: res = neg(op("|", a, b)); break;
+        case core::bit2::nxor: res = neg(op("^", a, b)); break;
+        case core::bit2:: iff: res = op("&", neg(a), b); break;
+        case core::bit2::niff: res = op("|", neg(a), b); break;
+        // clang-format on
+        default: fe::unreachable();
+    }
+
+    return assign(bb, def->type(), name, "{}", res);
+}
+
+template<> std::string Emitter::lower<core::shr>(BB& bb, const Def* def, const std::string& name) {
+    auto shr    = force<core::shr>(def);
+    auto [a, b] = shr->args<2>([this](auto def) { return emit(def); });
+    return assign(bb, def->type(), name, "{}", binop(shr->callee(), def->type(), a, b));
+}
+
+template<> std::string Emitter::lower<core::wrap>(BB& bb, const Def* def, const std::string& name) {
+    auto wrap   = force<core::wrap>(def);
+    auto [a, b] = wrap->args<2>([this](auto def) { return emit(def); });
+    return assign(bb, def->type(), name, "{}", binop(wrap->callee(), def->type(), a, b));
+}
+
+template<> std::string Emitter::lower<core::div>(BB& bb, const Def* def, const std::string& name) {
+    auto div     = force<core::div>(def);
+    auto [m, xy] = div->args<2>();
+    auto [x, y]  = xy->projs<2>();
+    auto w       = *isa_int(x->type());
+    auto t       = convert(x->type());
+    emit_unsafe(m);
+    auto a = emit(x);
+    auto b = emit(y);
+
+    switch (div.id()) {
+        case core::div::sdiv: return assign(bb, def->type(), name, "{}", trunc(t, w, sext(w, a) + " / " + sext(w, b)));
+        case core::div::udiv: return assign(bb, def->type(), name, "{} / {}", a, b);
+        case core::div::srem: return assign(bb, def->type(), name, "{}", trunc(t, w, sext(w, a) + " % " + sext(w, b)));
+        case core::div::urem: return assign(bb, def->type(), name, "{} % {}", a, b);
+        default: fe::unreachable();
+    }
+}
+
+template<> std::string Emitter::lower<core::icmp>(BB& bb, const Def* def, const std::string& name) {
+    auto icmp   = force<core::icmp>(def);
+    auto [a, b] = icmp->args<2>([this](auto def) { return emit(def); });
+    auto w      = *isa_int(icmp->arg(0)->type());
+
+    const char* op;
+    bool is_signed = false;
+    switch (icmp.id()) {
+        // clang-format off
+        case core::icmp::e:   op = "=="; break;
+        case core::icmp::ne:  op = "!="; break;
+        case core::icmp::sg:  op = ">" ; is_signed = true; break;
+        case core::icmp::sge: op = ">="; is_signed = true; break;
+        case core::icmp::sl:  op = "<" ; is_signed = true; break;
+        case core::icmp::sle: op = "<="; is_signed = true; break;
+        case core::icmp::ug:  op = ">" ; break;
+        case core::icmp::uge: op = ">="; break;
+        case core::icmp::ul:  op = "<" ; break;
+        case core::icmp::ule: op = "<="; break;
+        // clang-format on
+        default: fe::unreachable();
+    }
+
+    if (is_signed) return assign(bb, def->type(), name, "{} {} {}", sext(w, a), op, sext(w, b));
+    return assign(bb, def->type(), name, "{} {} {}", a, op, b);
+}
+
+template<> std::string Emitter::lower<core::extrema>(BB& bb, const Def* def, const std::string& name) {
+    auto extr   = force<core::extrema>(def);
+    auto [x, y] = extr->args<2>();
+    auto a      = emit(x);
+    auto b      = emit(y);
+    auto w      = *isa_int(x->type());
+
+    switch (extr.id()) {
+        case core::extrema::Sm: return assign(bb, def->type(), name, "{} < {} ? {} : {}", sext(w, a), sext(w, b), a, b);
+        case core::extrema::SM: return assign(bb, def->type(), name, "{} > {} ? {} : {}", sext(w, a), sext(w, b), a, b);
+        case core::extrema::sm: return assign(bb, def->type(), name, "{} < {} ? {} : {}", a, b, a, b);
+        case core::extrema::sM: return assign(bb, def->type(), name, "{} > {} ? {} : {}", a, b, a, b);
+        default: fe::unreachable();
+    }
+}
+
+template<> std::string Emitter::lower<core::abs>(BB& bb, const Def* def, const std::string& name) {
+    auto abs    = force<core::abs>(def);
+    auto [m, x] = abs->args<2>();
+    auto w      = *isa_int(x->type());
+    auto a      = sext(w, emit(x));
+    return assign(bb, def->type(), name, "{}", trunc(convert(x->type()), w, fmt("{} < 0 ? -{} : {}", a, a, a)));
+}
+
+template<> std::string Emitter::lower<core::conv>(BB& bb, const Def* def, const std::string& name) {
+    auto conv  = force<core::conv>(def);
+    auto v_src = emit(conv->arg());
+    auto t_dst = convert(conv->type());
+
+    nat_t w_src = *isa_int(conv->arg()->type());
+    nat_t w_dst = *isa_int(conv->type());
+
+    if (w_src == w_dst) return v_src;
+
+    // converting a signed value to a wider unsigned type sign-extends it
+    if (conv.id() == core::conv::s && w_src < w_dst) v_src = sext(w_src, v_src);
+    return assign(bb, def->type(), name, "{}", trunc(t_dst, w_dst, v_src));
+}
+
+template<> std::string Emitter::lower<core::bitcast>(BB& bb, const Def* def, const std::string& name) {
+    auto bitcast      = force<core::bitcast>(def);
+    auto dst_type_ptr = match<mem::Ptr>(bitcast->type());
+    auto src_type_ptr = match<mem::Ptr>(bitcast->arg()->type());
+    auto v_src        = emit(bitcast->arg());
+    auto t_dst        = convert(bitcast->type());
+
+    if (auto lit = Lit::isa(bitcast->arg()); lit && *lit == 0) return zero(bitcast->type());
+    if (src_type_ptr && dst_type_ptr) return assign(bb, def->type(), name, "({}){}", t_dst, v_src);
+    if (src_type_ptr || dst_type_ptr) return assign(bb, def->type(), name, "({})(uintptr_t){}", t_dst, v_src);
+
+    auto w_src = isa_int(bitcast->arg()->type());
+    auto w_dst = isa_int(bitcast->type());
+    if (w_src && w_dst) {
+        if (w_src == w_dst) return v_src;
+        return assign(bb, def->type(), name, "{}", trunc(t_dst, *w_dst, v_src));
+    }
+
+    // reinterpret the bits of, e.g., a float as an integer
+    include("string.h");
+    auto src = assign(bb, bitcast->arg()->type(), name + "_src", "{}", v_src);
+    local(t_dst, name);
+    bb.body("memcpy(&{}, &{}, sizeof({}));", name, src, name);
+    return name;
+}
+
+template<> std::string Emitter::lower<mem::lea>(BB& bb, const Def* def, const std::string& name) {
+    auto lea      = force<mem::lea>(def);
+    auto [ptr, i] = lea->args<2>();
+    auto pointee  = force<mem::Ptr>(ptr->type())->arg(0);
+    auto v_ptr    = emit(ptr);
+    if (pointee->isa<Sigma>()) return assign(bb, def->type(), name, "&{}->e{}", v_ptr, Lit::as(i));
+
+    auto arr = pointee->as<Arr>();
+    auto v_i = emit(i);
+    if (Lit::isa(arr->shape())) return assign(bb, def->type(), name, "&{}->e[{}]", v_ptr, v_i);
+    return assign(bb, def->type(), name, "&{}[{}]", v_ptr, v_i);
+}
+
+template<> std::string Emitter::lower<mem::malloc>(BB& bb, const Def* def, const std::string& name) {
+    auto malloc = force<mem::malloc>(def);
+    include("stdlib.h");
+
+    emit_unsafe(malloc->arg(0));
+    auto size = emit(malloc->arg(1));
+    return assign(bb, def->proj(1)->type(), name, "malloc({})", size);
+}
+
+template<> std::string Emitter::lower<mem::free>(BB& bb, const Def* def, const std::string&) {
+    auto free = force<mem::free>(def);
+    include("stdlib.h");
+
+    emit_unsafe(free->arg(0));
+    auto ptr = emit(free->arg(1));
+    bb.tail("free({});", ptr);
+    return {};
+}
+
+template<> std::string Emitter::lower<mem::mslot>(BB& bb, const Def* def, const std::string& name) {
+    auto mslot = force<mem::mslot>(def);
+    emit_unsafe(mslot->arg(0));
+    // TODO array with size
+    auto [pointee, addr_space] = mslot->decurry()->args<2>();
+    local(convert(pointee), name + "_slot");
+    return assign(bb, def->proj(1)->type(), name, "&{}_slot", name);
+}
+
+template<> std::string Emitter::lower<mem::load>(BB& bb, const Def* def, const std::string& name) {
+    auto load = force<mem::load>(def);
+    emit_unsafe(load->arg(0));
+    auto v_ptr = emit(load->arg(1));
+    return assign(bb, def->type(), name, "*{}", v_ptr);
+}
+
+template<> std::string Emitter::lower<mem::store>(BB& bb, const Def* def, const std::string&) {
+    auto store = force<mem::store>(def);
+    emit_unsafe(store->arg(0));
+    auto v_ptr = emit(store->arg(1));
+    auto v_val = emit(store->arg(2));
+    bb.body("*{} = {};", v_ptr, v_val);
+    return {};
+}
+
+template<> std::string Emitter::lower<clos::alloc_jmpbuf>(BB& bb, const Def* def, const std::string& name) {
+    auto q = force<clos::alloc_jmpbuf>(def);
+    include("setjmp.h");
+
+    emit_unsafe(q->arg());
+    local("jmp_buf", name + "_buf");
+    return assign(bb, def->proj(1)->type(), name, "(void*){}_buf", name);
+}
+
+template<> std::string Emitter::lower<clos::setjmp>(BB& bb, const Def* def, const std::string& name) {
+    auto setjmp = force<clos::setjmp>(def);
+    include("setjmp.h");
+
+    auto [mem, jmpbuf] = setjmp->arg()->projs<2>();
+    emit_unsafe(mem);
+    auto v_jb = emit(jmpbuf);
+    return assign(bb, def->type(), name, "setjmp(*(jmp_buf*){})", v_jb);
+}
+
+template<> std::string Emitter::lower<math::arith>(BB& bb, const Def* def, const std::string& name) {
+    auto arith  = force<math::arith>(def);
+    auto [a, b] = arith->args<2>([this](auto def) { return emit(def); });
+    return assign(bb, def->type(), name, "{}", binop(arith->callee(), def->type(), a, b));
+}
+
+template<> std::string Emitter::lower<math::tri>(BB& bb, const Def* def, const std::string& name) {
+    auto tri = force<math::tri>(def);
+    auto a   = emit(tri->arg());
+    include("math.h");
+
+    std::string f;
+    if (tri.sub() & sub_t(math::tri::a)) f += "a";
+
+    switch (math::tri((tri.id() & 0x3) | Annex::Base<math::tri>)) {
+        case math::tri::sin: f += "sin"; break;
+        case math::tri::cos: f += "cos"; break;
+        case math::tri::tan: f += "tan"; break;
+        case math::tri::ahFF: error("this axiom is supposed to be unused");
+        default: fe::unreachable();
+    }
+
+    if (tri.sub() & sub_t(math::tri::h)) f += "h";
+    f += core::math_suffix(tri->type());
+    return assign(bb, def->type(), name, "{}({})", f, a);
+}
+
+template<> std::string Emitter::lower<math::extrema>(BB& bb, const Def* def, const std::string& name) {
+    auto extrema = force<math::extrema>(def);
+    auto [a, b]  = extrema->args<2>([this](auto def) { return emit(def); });
+    include("math.h");
+
+    // C99 has no counterpart of IEEE 754-2019's NaN-propagating minimum/maximum
+    std::string f;
+    switch (extrema.id()) {
+        case math::extrema::fmin:
+        case math::extrema::ieee754min: f = "fmin"; break;
+        case math::extrema::fmax:
+        case math::extrema::ieee754max: f = "fmax"; break;
+        default: fe::unreachable();
+    }
+    f += core::math_suffix(extrema->type());
+    return assign(bb, def->type(), name, "{}({}, {})", f, a, b);
+}
+
+template<> std::string Emitter::lower<math::pow>(BB& bb, const Def* def, const std::string& name) {
+    auto pow    = force<math::pow>(def);
+    auto [a, b] = pow->args<2>([this](auto def) { return emit(def); });
+    include("math.h");
+    return assign(bb, def->type(), name, "pow{}({}, {})", core::math_suffix(pow->type()), a, b);
+}
+
+template<> std::string Emitter::lower<math::rt>(BB& bb, const Def* def, const std::string& name) {
+    auto rt = force<math::rt>(def);
+    auto a  = emit(rt->arg());
+    include("math.h");
+    auto f = rt.id() == math::rt::sq ? "sqrt" : "cbrt";
+    return assign(bb, def->type(), name, "{}{}({})", f, core::math_suffix(rt->type()), a);
+}
+
+template<> std::string Emitter::lower<math::exp>(BB& bb, const Def* def, const std::string& name) {
+    auto exp = force<math::exp>(def);
+    auto a   = emit(exp->arg());
+    auto s   = core::math_suffix(exp->type());
+    include("math.h");
+
+    bool is_log = exp.sub() & sub_t(math::exp::log);
+    if (exp.sub() & sub_t(math::exp::dec)) {
+        // C99 has log10 but no exp10
+        if (is_log) return assign(bb, def->type(), name, "log10{}({})", s, a);
+        return assign(bb, def->type(), name, "pow{}(10, {})", s, a);
+    }
+
+    auto f = std::string(is_log ? "log" : "exp") + ((exp.sub() & sub_t(math::exp::bin)) ? "2" : "");
+    return assign(bb, def->type(), name, "{}{}({})", f, s, a);
+}
+
+template<> std::string Emitter::lower<math::er>(BB& bb, const Def* def, const std::string& name) {
+    auto er = force<math::er>(def);
+    auto a  = emit(er->arg());
+    include("math.h");
+    auto f = er.id() == math::er::f ? "erf" : "erfc";
+    return assign(bb, def->type(), name, "{}{}({})", f, core::math_suffix(er->type()), a);
+}
+
+template<> std::string Emitter::lower<math::gamma>(BB& bb, const Def* def, const std::string& name) {
+    auto gamma = force<math::gamma>(def);
+    auto a     = emit(gamma->arg());
+    include("math.h");
+    auto f = gamma.id() == math::gamma::t ? "tgamma" : "lgamma";
+    return assign(bb, def->type(), name, "{}{}({})", f, core::math_suffix(gamma->type()), a);
+}
+
+template<> std::string Emitter::lower<math::cmp>(BB& bb, const Def* def, const std::string& name) {
+    auto cmp    = force<math::cmp>(def);
+    auto [a, b] = cmp->args<2>([this](auto def) { return emit(def); });
+    include("math.h");
+
+    // The relational operators of C are ordered; the unordered variants negate the inverse comparison.
+    switch (cmp.id()) {
+        // clang-format off
+        case math::cmp::  e: return assign(bb, def->type(), name, "{} == {}", a, b);
+        case math::cmp::  l: return assign(bb, def->type(), name, "{} < {}", a, b);
+        case math::cmp:: le: return assign(bb, def->type(), name, "{} <= {}", a, b);
+        case math::cmp::  g: return assign(bb, def->type(), name, "{} > {}", a, b);
+        case math::cmp:: ge: return assign(bb, def->type(), name, "{} >= {}", a, b);
+        case math::cmp:: ne: return assign(bb, def->type(), name, "{} < {} || {} > {}", a, b, a, b);
+        case math::cmp::  o: return assign(bb, def->type(), name, "!isunordered({}, {})", a, b);
+        case math::cmp::  u: return assign(bb, def->type(), name, "isunordered({}, {})", a, b);
+        case math::cmp:: ue: return assign(bb, def->type(), name, "isunordered({}, {}) || {} == {}", a, b, a, b);
+        case math::cmp:: ul: return assign(bb, def->type(), name, "!({} >= {})", a, b);
+        case math::cmp::ule: return assign(bb, def->type(), name, "!({} > {})", a, b);
+        case math::cmp:: ug: return assign(bb, def->type(), name, "!({} <= {})", a, b);
+        case math::cmp::uge: return assign(bb, def->type(), name, "!({} < {})", a, b);
+        case math::cmp::une: return assign(bb, def->type(), name, "{} != {}", a, b);
+        // clang-format on
+        default: fe::unreachable();
+    }
+}
+
+template<> std::string Emitter::lower<math::conv>(BB& bb, const Def* def, const std::string& name) {
+    auto conv  = force<math::conv>(def);
+    auto v_src = emit(conv->arg());
+    auto t_dst = convert(conv->type());
+
+    switch (conv.id()) {
+        case math::conv::s2f:
+            return assign(bb, def->type(), name, "({}){}", t_dst, sext(*isa_int(conv->arg()->type()), v_src));
+        case math::conv::f2s: {
+            auto w = *isa_int(conv->type());
+            return assign(bb, def->type(), name, "{}", trunc(t_dst, w, fmt("({}){}", int_t(w, true), v_src)));
+        }
+        case math::conv::f2f:
+        case math::conv::u2f:
+        case math::conv::f2u: return assign(bb, def->type(), name, "({}){}", t_dst, v_src);
+        default: fe::unreachable();
+    }
+}
+
+template<> std::string Emitter::lower<math::abs>(BB& bb, const Def* def, const std::string& name) {
+    auto abs = force<math::abs>(def);
+    auto a   = emit(abs->arg());
+    include("math.h");
+    return assign(bb, def->type(), name, "fabs{}({})", core::math_suffix(abs->type()), a);
+}
+
+template<> std::string Emitter::lower<math::round>(BB& bb, const Def* def, const std::string& name) {
+    auto round = force<math::round>(def);
+    auto a     = emit(round->arg());
+    include("math.h");
+
+    std::string f;
+    switch (round.id()) {
+        case math::round::f: f = "floor"; break;
+        case math::round::c: f = "ceil"; break;
+        case math::round::r: f = "round"; break;
+        case math::round::t: f = "trunc"; break;
+        default: fe::unreachable();
+    }
+    f += core::math_suffix(round->type());
+    return assign(bb, def->type(), name, "{}({})", f, a);
+}
+
+/// Only the element-wise application of a binary operation on arrays is supported which becomes a loop.
+template<> std::string Emitter::lower<core::zip>(BB& bb, const Def* def, const std::string& name) {
+    auto zip    = force<core::zip>(def);
+    auto callee = zip->decurry(); // %core.zip (r, s) (n_i, Is, n_o, Os, f)
+    auto r      = Lit::isa(callee->decurry()->arg(0));
+    auto n_i    = Lit::isa(callee->arg(0));
+    auto n_o    = Lit::isa(callee->arg(2));
+    auto arr    = zip->type()->isa<Arr>();
+
+    auto [a, b] = zip->args<2>([this](auto def) { return emit(def); });
+    auto op     = arr ? binop(callee->arg(4), arr->body(), a + ".e[i]", b + ".e[i]") : ""s;
+    if (op.empty() || r != 1 || n_i != 2 || n_o != 1)
+        error("C backend can only emit %core.zip of element-wise binary operations on arrays: {}", def);
+
+    local(convert(zip->type()), name);
+    bb.body("for (uint64_t i = 0; i != {}; ++i) {}.e[i] = {};", Lit::as(arr->shape()), name, op);
+    return name;
+}
+
+const Emitter::Lowerings& Emitter::lowerings() {
+    static const auto lowerings = [] {
+        Lowerings lowerings;
+        add<core::nat, core::ncmp, core::idx, core::bit1, core::bit2, core::shr, core::wrap, core::div, core::icmp,
+            core::extrema, core::abs, core::conv, core::bitcast, core::zip>(lowerings);
+        add<mem::lea, mem::malloc, mem::free, mem::mslot, mem::load, mem::store>(lowerings);
+        add<clos::alloc_jmpbuf, clos::setjmp>(lowerings);
+        add<math::arith, math::tri, math::extrema, math::pow, math::rt, math::exp, math::er, math::gamma, math::cmp,
+            math::conv, math::abs, math::round>(lowerings);
+        return lowerings;
+    }();
+    return lowerings;
+}
+
+void emit(World& world, std::ostream& ostream) {
+    Emitter emitter(world, ostream);
+    emitter.run();
+}
+
+} // namespace thorin::c
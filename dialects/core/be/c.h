@@ -0,0 +1,16 @@
+#pragma once
+
+#include <ostream>
+
+namespace thorin {
+
+class World;
+
+namespace c {
+
+/// Emits @p world as a self-contained C99 translation unit.
+/// Basic blocks become labels and `goto`s; an external `main` is wrapped in a conforming `int main(int, char**)`.
+void emit(World&, std::ostream&);
+
+} // namespace c
+} // namespace thorin
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "dialects/math/math.h"
+#include "dialects/mem/mem.h"
+
+/// Helpers shared by the backends in core/be and the lowerings of the Plugin%s.
+namespace thorin::core {
+
+/// Is @p def built from Lit%s, Bot%s, Tuple%s, and Pack%s only - i.e. a constant for C and LLVM?
+inline bool is_const(const Def* def) {
+    if (def->isa<Bot>()) return true;
+    if (def->isa<Lit>()) return true;
+    if (auto pack = def->isa_imm<Pack>()) return is_const(pack->shape()) && is_const(pack->body());
+
+    if (auto tuple = def->isa<Tuple>()) {
+        auto ops = tuple->ops();
+        return std::ranges::all_of(ops, [](auto def) { return is_const(def); });
+    }
+
+    return false;
+}
+
+// [%mem.M, T] => T
+// TODO there may be more instances where we have to deal with this trickery
+inline Ref isa_mem_sigma_2(Ref type) {
+    if (auto sigma = type->isa<Sigma>())
+        if (sigma->num_ops() == 2 && match<mem::M>(sigma->op(0))) return sigma->op(1);
+    return {};
+}
+
+/// Suffix of the libm function for the floating-point @p type - e.g. `sinf` vs `sin`.
+inline const char* math_suffix(const Def* type) {
+    if (auto w = math::isa_f(type)) {
+        switch (*w) {
+            case 32: return "f";
+            case 64: return "";
+        }
+    }
+    error("unsupported foating point type '{}'", type);
+}
+
+} // namespace thorin::core
@@ -0,0 +1,138 @@
+#include <chrono>
+#include <mutex>
+
+#include <absl/container/flat_hash_map.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/ExecutionEngine/Orc/CompileUtils.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <thorin/config.h>
+
+#include "thorin/driver.h"
+#include "thorin/world.h"
+
+#include "thorin/analyses/fingerprint.h"
+
+#include "dialects/core/be/ll.h"
+#include "dialects/core/be/llvm.h"
+
+namespace thorin::ll {
+
+namespace {
+
+using Main = int (*)(int, char**);
+
+/// A JIT-compiled module that stays alive as long as the process in order to serve later identical requests.
+struct Compiled {
+    std::unique_ptr<llvm::orc::LLJIT> jit;
+    Main main = nullptr;
+};
+
+/// In-process cache: Only helps if the same process JITs the same World several times.
+/// Across processes, the object code is reused via Driver::cache.
+struct Cache {
+    std::mutex mutex;
+    absl::flat_hash_map<std::string, Compiled> key2compiled;
+    size_t hits   = 0;
+    size_t misses = 0;
+};
+
+Cache& cache() {
+    static Cache cache;
+    return cache;
+}
+
+template<class T> T check(llvm::Expected<T> expected) {
+    if (!expected) error("LLVM JIT: {}", llvm::toString(expected.takeError()));
+    return std::move(*expected);
+}
+
+void check(llvm::Error err) {
+    if (err) error("LLVM JIT: {}", llvm::toString(std::move(err)));
+}
+
+/// Links the object code @p obj - either just compiled or taken from Driver::cache - into a fresh `LLJIT`.
+Compiled jit_link(llvm::orc::JITTargetMachineBuilder jtmb, std::unique_ptr<llvm::MemoryBuffer> obj) {
+    using namespace llvm::orc;
+    auto jit = check(LLJITBuilder().setJITTargetMachineBuilder(std::move(jtmb)).create());
+
+    // resolve calls into libc & friends against the running process
+    auto prefix = jit->getDataLayout().getGlobalPrefix();
+    jit->getMainJITDylib().addGenerator(check(DynamicLibrarySearchGenerator::GetForCurrentProcess(prefix)));
+    check(jit->addObjectFile(std::move(obj)));
+
+    auto sym = check(jit->lookup("main"));
+#if LLVM_VERSION_MAJOR >= 15
+    auto main = sym.toPtr<Main>();
+#else
+    auto main = reinterpret_cast<Main>(sym.getAddress());
+#endif
+    return {std::move(jit), main};
+}
+
+} // namespace
+
+int jit(World& world, int argc, char** argv) {
+    using namespace llvm::orc;
+    using Clock = std::chrono::steady_clock;
+    auto begin  = Clock::now();
+
+    in_process::init();
+    auto jtmb = check(JITTargetMachineBuilder::detectHost());
+    jtmb.setCodeGenOptLevel(llvm::CodeGenOpt::Aggressive);
+
+    // The structural Fingerprint of the World determines the object code for this host - no need to emit anything.
+    auto fp = Fingerprint(world).add(THORIN_VER).add(LLVM_VERSION_STRING).add(world.name().str());
+    fp.add(jtmb.getTargetTriple().str()).add(jtmb.getCPU()).add(jtmb.getFeatures().getString());
+    // the lowering - this very plugin included - lives in the plugins
+    for (const auto& file : world.driver().plugin_files()) fp.add_file(file);
+    auto key = fp.str() + ".jit.o";
+
+    Main main;
+    {
+        auto& c    = cache();
+        auto guard = std::lock_guard(c.mutex);
+        auto i     = c.key2compiled.find(key);
+        if (i != c.key2compiled.end()) {
+            ++c.hits;
+        } else {
+            ++c.misses;
+            std::unique_ptr<llvm::MemoryBuffer> obj;
+            auto disk = world.driver().cache();
+            if (auto data = disk ? disk->lookup(key) : std::nullopt) {
+                obj = llvm::MemoryBuffer::getMemBufferCopy(*data, key);
+                world.VLOG("JIT: reusing object code '{}' from cache", key);
+            } else {
+                auto machine = check(jtmb.createTargetMachine());
+                llvm::LLVMContext context;
+                auto module = in_process::emit(world, context);
+                module->setDataLayout(machine->createDataLayout());
+                module->setTargetTriple(machine->getTargetTriple().str());
+                in_process::optimize(*module, machine.get());
+                obj = check(SimpleCompiler(*machine)(*module));
+                if (disk) disk->insert(key, obj->getBuffer());
+            }
+            i = c.key2compiled.emplace(key, jit_link(std::move(jtmb), std::move(obj))).first;
+        }
+        main = i->second.main;
+
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - begin).count();
+        world.VLOG("JIT: {}ms to obtain 'main' ({}); in-process cache: {} hits, {} misses", ms, key, c.hits,
+                   c.misses);
+    }
+
+    if (!main) error("LLVM JIT: no 'main' found");
+    return main(argc, argv);
+}
+
+void run(World& world, std::ostream& os) {
+    auto name    = world.name().str();
+    char* argv[] = {name.data(), nullptr};
+    os << jit(world, 1, argv);
+}
+
+} // namespace thorin::ll
@@ -1,17 +1,26 @@
 #include "dialects/core/be/ll.h"
 
+#include <bit>
+#include <chrono>
 #include <deque>
 #include <fstream>
 #include <iomanip>
 #include <limits>
+#include <random>
 #include <ranges>
+#include <thread>
+
+#include "thorin/driver.h"
 
 #include "thorin/analyses/cfg.h"
+#include "thorin/analyses/profile.h"
 #include "thorin/be/emitter.h"
+#include "thorin/be/ll/lowerer.h"
 #include "thorin/util/print.h"
 #include "thorin/util/sys.h"
 
 #include "dialects/clos/clos.h"
+#include "dialects/core/be/helper.h"
 #include "dialects/core/core.h"
 #include "dialects/math/math.h"
 #include "dialects/mem/mem.h"
@@ -32,87 +41,333 @@ using namespace std::string_literals;
 namespace thorin::ll {
 
 namespace {
-bool is_const(const Def* def) {
-    if (def->isa<Bot>()) return true;
-    if (def->isa<Lit>()) return true;
-    if (auto pack = def->isa_imm<Pack>()) return is_const(pack->shape()) && is_const(pack->body());
-
-    if (auto tuple = def->isa<Tuple>()) {
-        auto ops = tuple->ops();
-        return std::ranges::all_of(ops, [](auto def) { return is_const(def); });
-    }
 
-    return false;
+constexpr nat_t Max_Vec_Bits = 512; ///< Largest vector register we aim for (AVX-512).
+
+/// Element-wise arithmetic on small, homogeneous arrays of integers or floats whose arity is a power of two is
+/// carried out on LLVM vectors `<N x T>`.
+/// The arrays themselves remain `[N x T]` - in memory and at function boundaries their layout and ABI don't change.
+/// @returns the arity `N` in this case.
+std::optional<nat_t> isa_vec(Ref type) {
+    auto arr = type->isa<Arr>();
+    if (!arr) return {};
+
+    auto n = Lit::isa(arr->shape());
+    if (!n || *n < 2 || !std::has_single_bit(*n)) return {};
+
+    nat_t w = 0;
+    if (auto size = Idx::size(arr->body()))
+        w = Idx::size2bitwidth(size).value_or(0);
+    else if (auto f = math::isa_f(arr->body()))
+        w = *f;
+
+    // i1 vectors are stored bit-packed and, hence, differ in layout from [N x i1]
+    if (w < 8 || !std::has_single_bit(w) || *n * w > Max_Vec_Bits) return {};
+    return n;
 }
 
-const char* math_suffix(const Def* type) {
-    if (auto w = math::isa_f(type)) {
-        switch (*w) {
-            case 32: return "f";
-            case 64: return "";
+/// Yields the LLVM instruction for `f (a, b)`, if @p f is an element-wise binary operation.
+/// As LLVM's arithmetic instructions work on both scalars and vectors, this is shared by both.
+std::optional<std::string> isa_binop(Ref f) {
+    auto [axiom, curry, _] = Axiom::get(f);
+    if (!axiom || curry != 1) return {};
+
+    std::string op;
+    switch (axiom->base()) {
+        case Annex::Base<core::wrap>: {
+            switch (core::wrap(axiom->flags())) {
+                case core::wrap::add: op = "add"; break;
+                case core::wrap::sub: op = "sub"; break;
+                case core::wrap::mul: op = "mul"; break;
+                case core::wrap::shl: op = "shl"; break;
+            }
+
+            auto mode = Lit::as(f->as<App>()->arg());
+            if (mode & core::Mode::nuw) op += " nuw";
+            if (mode & core::Mode::nsw) op += " nsw";
+            return op;
         }
+        case Annex::Base<core::shr>: return core::shr(axiom->flags()) == core::shr::a ? "ashr"s : "lshr"s;
+        case Annex::Base<math::arith>: {
+            switch (math::arith(axiom->flags())) {
+                case math::arith::add: op = "fadd"; break;
+                case math::arith::sub: op = "fsub"; break;
+                case math::arith::mul: op = "fmul"; break;
+                case math::arith::div: op = "fdiv"; break;
+                case math::arith::rem: op = "frem"; break;
+            }
+
+            auto mode = Lit::as(f->as<App>()->arg());
+            if (mode == math::Mode::fast)
+                op += " fast";
+            else {
+                // clang-format off
+                if (mode & math::Mode::nnan    ) op += " nnan";
+                if (mode & math::Mode::ninf    ) op += " ninf";
+                if (mode & math::Mode::nsz     ) op += " nsz";
+                if (mode & math::Mode::arcp    ) op += " arcp";
+                if (mode & math::Mode::contract) op += " contract";
+                if (mode & math::Mode::afn     ) op += " afn";
+                if (mode & math::Mode::reassoc ) op += " reassoc";
+                // clang-format on
+            }
+            return op;
+        }
+        default: return {};
     }
-    error("unsupported foating point type '{}'", type);
 }
 
-const char* llvm_suffix(const Def* type) {
-    if (auto w = math::isa_f(type)) {
-        switch (*w) {
-            case 16: return ".f16";
-            case 32: return ".f32";
-            case 64: return ".f64";
+/// Tracks pointers that stem from a fresh allocation which never escapes.
+/// Such a pointer - and every pointer derived from it via %mem.lea - may only be loaded from, stored to
+/// (but not stored *somewhere*), or passed to a Lam whose corresponding Var in turn doesn't escape.
+/// In the latter case, *every* call of that Lam must pass a pointer based on the same allocation.
+class Provenance {
+public:
+    /// Yields the allocation @p ptr is based on, if it doesn't escape; `nullptr` otherwise.
+    const Def* alloc(const Def* ptr) {
+        auto i = ptr2alloc_.find(ptr);
+        if (i != ptr2alloc_.end()) return i->second;
+        if (auto lea = match<mem::lea>(ptr)) return ptr2alloc_[ptr] = alloc(lea->arg(0));
+
+        auto ex = ptr->isa<Extract>();
+        if (ex && Lit::isa(ex->index()) == 1
+            && (match<mem::alloc>(ex->tuple()) || match<mem::malloc>(ex->tuple()) || match<mem::slot>(ex->tuple())
+                || match<mem::mslot>(ex->tuple()))) {
+            if (auto& set = derived(ptr); !set.empty()) {
+                for (auto d : set) ptr2alloc_[d] = ptr;
+                return ptr;
+            }
         }
+
+        return ptr2alloc_[ptr] = nullptr;
     }
-    error("unsupported foating point type '{}'", type);
+
+    /// All pointers based on @p alloc - including @p alloc itself - or the empty set, if @p alloc escapes.
+    const DefSet& derived(const Def* alloc) {
+        auto [i, inserted] = alloc2derived_.emplace(alloc, DefSet());
+        if (!inserted) return i->second;
+
+        auto& set = i->second;
+        unique_queue<DefSet> queue;
+        Params params;
+        queue.push(alloc);
+        while (!queue.empty()) {
+            auto ptr = queue.pop();
+            set.emplace(ptr);
+            for (auto use : ptr->uses()) {
+                if (!flows(use, queue, params)) return set.clear(), set;
+            }
+        }
+
+        // other calls may pass a different pointer to the same Var
+        for (auto [lam, i] : params) {
+            auto n = lam->num_vars();
+            if (!calls(lam, [&](const App* app) { return set.contains(app->arg(n, i)); })) return set.clear(), set;
+        }
+
+        return set;
+    }
+
+private:
+    using Params = std::vector<std::pair<Lam*, size_t>>; ///< The @p i-th Var of `lam` receives a derived pointer.
+
+    /// Does the pointer that is used by @p use stay contained? If so, enqueue pointers derived from it.
+    static bool flows(Use use, unique_queue<DefSet>& queue, Params& params) {
+        if (auto app = use->isa<App>(); app && use.index() == 1) return into(app, 0, 1, queue, params);
+        if (!use->isa<Tuple>()) return false;
+
+        for (auto tuse : use->uses()) {
+            auto app = tuse->isa<App>();
+            if (!app || tuse.index() != 1) return false;
+
+            // clang-format off
+            if (match<mem::load >(app)) { if (use.index() != 1) return false; continue; }
+            if (match<mem::store>(app)) { if (use.index() != 1) return false; continue; }
+            if (match<mem::lea  >(app)) { if (use.index() != 0) return false; queue.push(app); continue; }
+            // clang-format on
+            if (!into(app, use.index(), use->num_ops(), queue, params)) return false;
+        }
+
+        return true;
+    }
+
+    /// Follows the @p i-th of @p n arguments of @p app into the callee's Var - or into all targets of a branch.
+    static bool into(const App* app, size_t i, size_t n, unique_queue<DefSet>& queue, Params& params) {
+        if (auto branch = app->callee()->isa<Extract>(); branch && branch->tuple()->isa<Tuple>())
+            return std::ranges::all_of(branch->tuple()->ops(), [&](Ref l) { return into(l, i, n, queue, params); });
+        return into(app->callee(), i, n, queue, params);
+    }
+
+    static bool into(Ref callee, size_t i, size_t n, unique_queue<DefSet>& queue, Params& params) {
+        auto lam = callee->isa_mut<Lam>();
+        if (!lam || lam->is_external() || lam->num_vars() != n) return false;
+        params.emplace_back(lam, i);
+        if (n == 1) return queue.push(lam->var()), true;
+
+        for (auto vuse : lam->var()->uses()) {
+            auto ex = vuse->isa<Extract>();
+            if (!ex) return false;
+            if (Lit::isa(ex->index()) == i) queue.push(ex);
+        }
+        return true;
+    }
+
+    /// Invokes @p f on each call of @p lam - directly or as target of a branch.
+    /// Yields `false`, if @p f does or if @p lam is used otherwise, as the calls are unknown then.
+    template<class F> static bool calls(Lam* lam, F f) {
+        for (auto use : lam->uses()) {
+            if (auto app = use->isa<App>(); app && use.index() == 0) {
+                if (!f(app)) return false;
+                continue;
+            }
+
+            if (!use->isa<Tuple>()) return false;
+            for (auto tuse : use->uses()) {
+                auto branch = tuse->isa<Extract>();
+                if (!branch || tuse.index() != 0) return false;
+                for (auto buse : branch->uses()) {
+                    auto app = buse->isa<App>();
+                    if (!app || buse.index() != 0 || !f(app)) return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    DefMap<const Def*> ptr2alloc_;
+    DefMap<DefSet> alloc2derived_;
+};
+
+/// Is @p jump the back edge of a counted loop headed by @p head - as built by affine::LowerFor?
+/// I.e., @p head branches on `iter < end` and @p jump passes `iter + step` as new `iter`.
+bool is_counted_loop(Lam* head, const App* jump) {
+    auto n      = head->num_vars();
+    auto branch = head->body() ? head->body()->isa<App>() : nullptr;
+    if (!branch || n == 0) return false;
+
+    auto ex = branch->callee()->isa<Extract>();
+    if (!ex || !ex->tuple()->isa<Tuple>()) return false;
+
+    auto cmp = match(core::icmp::ul, ex->index());
+    auto inc = match(core::wrap::add, jump->arg(n, 0));
+    auto iter = head->var(n, 0);
+    return cmp && inc && cmp->arg(0) == iter && inc->arg(0) == iter;
 }
 
-// [%mem.M, T] => T
-// TODO there may be more instances where we have to deal with this trickery
-Ref isa_mem_sigma_2(Ref type) {
-    if (auto sigma = type->isa<Sigma>())
-        if (sigma->num_ops() == 2 && match<mem::M>(sigma->op(0))) return sigma->op(1);
-    return {};
+/// Yields @p s as LLVM string constant `c"..."` including the terminating null character.
+std::string c_str(std::string_view s) {
+    std::ostringstream os;
+    os << "c\"" << std::hex << std::uppercase << std::setfill('0');
+    for (unsigned char c : s) {
+        if (c < 0x20 || c > 0x7e || c == '"' || c == '\\')
+            os << '\\' << std::setw(2) << unsigned(c);
+        else
+            os << c;
+    }
+    os << "\\00\"";
+    return os.str();
 }
 } // namespace
 
+/// Bump-pointer arena for instruction text.
+/// Each line is formatted into a reused scratch buffer and then copied into large chunks.
+/// This avoids one heap-allocated `std::ostringstream` per instruction.
+/// Everything is released en bloc via StrPool::clear once a function has been written.
+class StrPool {
+public:
+    /// @name Formatting
+    /// Either use StrPool::line or write to StrPool::begin and conclude with StrPool::end.
+    ///@{
+    std::ostream& begin() {
+        scratch_.str({});
+        return scratch_;
+    }
+    std::string_view end() { return store(scratch_.view()); }
+    template<class... Args> std::string_view line(const char* s, Args&&... args) {
+        print(begin(), s, std::forward<Args&&>(args)...);
+        return end();
+    }
+    ///@}
+
+    std::string_view store(std::string_view s) {
+        if (chunks_.empty() || chunks_.back().capacity() - chunks_.back().size() < s.size())
+            chunks_.emplace_back().reserve(std::max(Chunk_Size, s.size()));
+        auto& chunk = chunks_.back();
+        auto begin  = chunk.size();
+        chunk.append(s);
+        size_ += s.size();
+        peak_ = std::max(peak_, size_);
+        return {chunk.data() + begin, s.size()};
+    }
+
+    /// Invalidates all lines but keeps the first chunk for reuse.
+    void clear() {
+        if (chunks_.size() > 1) chunks_.resize(1);
+        if (!chunks_.empty()) chunks_.front().clear();
+        size_ = 0;
+    }
+
+    size_t peak() const { return peak_; } ///< Peak number of bytes used.
+
+private:
+    static constexpr size_t Chunk_Size = 64 * 1024;
+
+    std::deque<std::string> chunks_;
+    std::ostringstream scratch_;
+    size_t size_ = 0;
+    size_t peak_ = 0;
+};
+
 struct BB {
     BB()                    = default;
     BB(const BB&)           = delete;
     BB(BB&& other) noexcept = default;
     BB& operator=(BB other) noexcept { return swap(*this, other), *this; }
 
-    std::deque<std::ostringstream>& head() { return parts[0]; }
-    std::deque<std::ostringstream>& body() { return parts[1]; }
-    std::deque<std::ostringstream>& tail() { return parts[2]; }
+    std::deque<std::string_view>& head() { return parts[0]; }
+    std::deque<std::string_view>& body() { return parts[1]; }
+    std::deque<std::string_view>& tail() { return parts[2]; }
 
     template<class... Args> std::string assign(std::string_view name, const char* s, Args&&... args) {
-        print(print(body().emplace_back(), "{} = ", name), s, std::forward<Args&&>(args)...);
+        print(pool->begin() << name << " = ", s, std::forward<Args&&>(args)...);
+        body().emplace_back(pool->end());
         return std::string(name);
     }
 
+    template<class... Args> void body(const char* s, Args&&... args) {
+        body().emplace_back(pool->line(s, std::forward<Args&&>(args)...));
+    }
+
     template<class... Args> void tail(const char* s, Args&&... args) {
-        print(tail().emplace_back(), s, std::forward<Args&&>(args)...);
+        tail().emplace_back(pool->line(s, std::forward<Args&&>(args)...));
     }
 
     friend void swap(BB& a, BB& b) noexcept {
         using std::swap;
         swap(a.phis, b.phis);
         swap(a.parts, b.parts);
+        swap(a.pool, b.pool);
     }
 
     DefMap<std::deque<std::pair<std::string, std::string>>> phis;
-    std::array<std::deque<std::ostringstream>, 3> parts;
+    std::array<std::deque<std::string_view>, 3> parts;
+    StrPool* pool = nullptr; ///< Set by Emitter upon first use; all parts point into it.
 };
 
-class Emitter : public thorin::Emitter<std::string, std::string, BB, Emitter> {
+class Emitter final : public thorin::Emitter<std::string, std::string, BB, Emitter>, public Lowerer {
 public:
     using Super = thorin::Emitter<std::string, std::string, BB, Emitter>;
 
-    Emitter(World& world, std::ostream& ostream)
-        : Super(world, "llvm_emitter", ostream) {}
+    /// Only emits the functions of @p partition out of @p num_partitions; all others are merely declared.
+    Emitter(World& world, std::ostream& ostream, size_t partition = 0, size_t num_partitions = 1)
+        : Super(world, "llvm_emitter", ostream)
+        , partition_(partition)
+        , num_partitions_(num_partitions) {}
 
     bool is_valid(std::string_view s) { return !s.empty(); }
     void start() override;
+    void visit(const Scope&) override;
     void emit_imported(Lam*);
     void emit_epilogue(Lam*);
     std::string emit_bb(BB&, const Def*);
@@ -120,17 +375,97 @@ public:
     void prepare(Lam*, std::string_view);
     void finalize(const Scope&);
 
-    template<class... Args> void declare(const char* s, Args&&... args) {
-        std::ostringstream decl;
-        print(decl << "declare ", s, std::forward<Args&&>(args)...);
-        decls_.emplace(decl.str());
+
+    /// @name Lowerer
+    /// The lowerings of the Plugin%s write into Emitter::bb_.
+    ///@{
+    std::string emit(const Def* def) override { return Super::emit(def); }
+    std::string emit_unsafe(const Def* def) override { return Super::emit_unsafe(def); }
+    std::string convert(const Def*) override;
+    std::pair<std::string, std::string> gep_index(const Def* index, const std::string& name) override {
+        return emit_gep_index(*bb_, index, name);
+    }
+    std::optional<std::string> binop(Ref f) override { return isa_binop(f); }
+    std::string tbaa(const Def* ptr) override;
+    ///@}
+
+    /// Registers the lowerings of the core Plugin's Axiom%s.
+    template<class... Ids> static void add(Lowerings& lowerings) {
+        (assert_emplace(lowerings, Annex::Base<Ids>, &Emitter::dispatch<Ids>), ...);
     }
 
+protected:
+    std::ostream& line() override { return pool_.begin(); }
+    void commit(Part part) override { (part == Part::Body ? bb_->body() : bb_->tail()).emplace_back(pool_.end()); }
+    void add_declaration(std::string decl) override { decls_.emplace(std::move(decl)); }
+
 private:
     std::string id(const Def*, bool force_bb = false) const;
-    std::string convert(const Def*);
     std::string convert_ret_pi(const Pi*);
-
+    /// In Flags::stream_ll mode, functions go directly to Emitter::ostream; otherwise, they are buffered.
+    std::ostream& impls() { return world().flags().stream_ll ? ostream() : func_impls_; }
+    BB& bb(Lam* lam) {
+        auto& bb = lam2bb_[lam];
+        bb.pool  = &pool_;
+        return bb;
+    }
+    /// @name Metadata
+    ///@{
+    /// Appends a new metadata node built from @p s and yields its id.
+    template<class... Args> std::string metadata(const char* s, Args&&... args) {
+        auto id = "!" + std::to_string(num_metadata_++);
+        print(print(metadata_, "{} = ", id), s, std::forward<Args&&>(args)...) << '\n';
+        return id;
+    }
+    std::string loop();
+    bool is_noalias(Lam*, size_t i);
+    ///@}
+
+    /// @name Profiling
+    /// See Flags::instrument and Profile.
+    ///@{
+    void count(BB&, Lam*);
+    void emit_profile_dump();
+    ///@}
+
+    std::string emit_tuple(BB&, const Def*, const std::string& name);
+    std::string emit_zip(BB&, const Def*, const std::string& name);
+    /// @name Vectors
+    /// Converts between an Arr value `[N x T]` and its vector `<N x T>`; see isa_vec.
+    ///@{
+    std::string vec_type(const Def* arr) { return fmt("<{} x {}>", *isa_vec(arr), convert(arr->as<Arr>()->body())); }
+    std::string to_vec(BB&, const Def*, const std::string& name);
+    std::string from_vec(BB&, const Def* type, const std::string& vec, const std::string& name);
+    ///@}
+    std::pair<std::string, std::string> emit_gep_index(BB&, const Def*, const std::string& name);
+
+    /// @name Lowerings
+    /// Instead of matching one Axiom after the other, Emitter::emit_bb looks up the rule for a fully applied Axiom
+    /// in Driver::lowering; so all subtags of an Axiom share one rule.
+    /// The rules of the core Plugin are Emitter::lower specializations as they need the internals of the Emitter.
+    ///@{
+    template<class Id> std::string lower(BB&, const Def*, const std::string& name);
+    template<class Id> static std::string dispatch(Lowerer& be, const Def* def, const std::string& name) {
+        auto& emitter = static_cast<Emitter&>(be);
+        return emitter.lower<Id>(*emitter.bb_, def, name);
+    }
+    ///@}
+
+    size_t partition_;
+    size_t num_partitions_;
+    size_t num_funs_ = 0;
+    DefMap<size_t> global2partition_; ///< Each Global is defined by the partition of the first function using it.
+    StrPool pool_;
+    BB* bb_ = nullptr; ///< Current basic block of a lowering.
+    Provenance provenance_;
+    DefMap<std::string> vecs_; ///< Vectors of the current function which are defined right along with the Arr value.
+    absl::flat_hash_map<std::string, std::string> tbaa_; ///< LLVM type of pointee -> access tag
+    std::string tbaa_char_;                              ///< TBAA type node of `i8` which may alias anything.
+    std::array<std::string, 2> loop_md_;                 ///< Properties shared by all `llvm.loop` nodes.
+    std::ostringstream metadata_;
+    size_t num_metadata_ = 0;
+    std::vector<std::string> counters_;                   ///< Profile::id%s counted in `@thorin.prof.<index>`.
+    absl::flat_hash_map<std::string, size_t> id2counter_; ///< Copies of the same Lam share one counter.
     absl::btree_set<std::string> decls_;
     std::ostringstream type_decls_;
     std::ostringstream vars_decls_;
@@ -187,7 +522,7 @@ std::string Emitter::convert(const Def* type) {
         assert(Pi::isa_returning(pi) && "should never have to convert type of BB");
         print(s, "{} (", convert_ret_pi(pi->ret_pi()));
 
-        if (auto t = isa_mem_sigma_2(pi->dom()))
+        if (auto t = core::isa_mem_sigma_2(pi->dom()))
             s << convert(t);
         else {
             auto doms = pi->doms();
@@ -198,7 +533,7 @@ std::string Emitter::convert(const Def* type) {
             }
         }
         s << ")*";
-    } else if (auto t = isa_mem_sigma_2(type)) {
+    } else if (auto t = core::isa_mem_sigma_2(type)) {
         return convert(t);
     } else if (auto sigma = type->isa<Sigma>()) {
         if (sigma->isa_mut()) {
@@ -235,14 +570,165 @@ std::string Emitter::convert_ret_pi(const Pi* pi) {
  * emit
  */
 
+/*
+ * metadata
+ */
+
+/// Yields a `!tbaa` attachment for accessing @p ptr or the empty string, if its pointee isn't a scalar.
+/// As in C, `i8` plays the role of `char` and may alias anything.
+/// Type-based alias analysis is only sound, if the memory is never accessed through a pointer of a different type.
+/// Hence, only pointers into an allocation that doesn't escape - and, thus, never goes through a `%core.bitcast` -
+/// get a tag. For a Var, Provenance checks every call site just like Emitter::is_noalias does.
+std::string Emitter::tbaa(const Def* ptr) {
+    if (!provenance_.alloc(ptr)) return {};
+
+    auto pointee   = force<mem::Ptr>(ptr->type())->arg(0);
+    bool is_scalar = pointee->isa<Nat>() || Idx::size(pointee) || math::isa_f(pointee) || match<mem::Ptr>(pointee);
+    if (!is_scalar) return {};
+
+    auto type = match<mem::Ptr>(pointee) ? "any pointer"s : convert(pointee);
+    if (auto i = tbaa_.find(type); i != tbaa_.end()) return i->second;
+
+    if (tbaa_char_.empty()) {
+        auto root  = metadata("!{{!\"thorin TBAA\"}}");
+        tbaa_char_ = metadata("!{{!\"omnipotent char\", {}, i64 0}}", root);
+    }
+
+    auto node = type == "i8" ? tbaa_char_ : metadata("!{{!\"{}\", {}, i64 0}}", type, tbaa_char_);
+    return tbaa_[type] = ", !tbaa " + metadata("!{{{}, {}, i64 0}}", node, node);
+}
+
+/// Every loop needs its own, distinct `llvm.loop` node while the properties are shared.
+/// Only used in Flags::loop_hints mode as these hints override LLVM's cost model.
+std::string Emitter::loop() {
+    if (loop_md_[0].empty()) {
+        loop_md_[0] = metadata("!{{!\"llvm.loop.vectorize.enable\", i1 true}}");
+        loop_md_[1] = metadata("!{{!\"llvm.loop.unroll.enable\"}}");
+    }
+
+    auto id = "!" + std::to_string(num_metadata_++);
+    print(metadata_, "{} = distinct !{{{}, {}, {}}}\n", id, id, loop_md_[0], loop_md_[1]);
+    return id;
+}
+
+/// The @p i-th Var of @p lam may be `noalias`, if
+/// * @p lam is internal and only called directly,
+/// * each call passes a pointer to a fresh allocation that doesn't escape, and
+/// * no other argument of that call is derived from the same allocation.
+bool Emitter::is_noalias(Lam* lam, size_t i) {
+    if (lam->is_external() || lam->num_uses() == 0) return false;
+
+    auto n = lam->num_vars();
+    for (auto use : lam->uses()) {
+        auto app = use->isa<App>();
+        if (!app || use.index() != 0 || app->num_args() != n) return false;
+
+        auto alloc = provenance_.alloc(app->arg(n, i));
+        if (!alloc) return false;
+
+        auto& derived = provenance_.derived(alloc);
+        for (size_t j = 0; j != n; ++j)
+            if (j != i && derived.contains(app->arg(n, j))) return false;
+    }
+
+    return true;
+}
+
 void Emitter::start() {
+    auto begin = std::chrono::steady_clock::now();
     Super::start();
+    if (!counters_.empty()) emit_profile_dump();
 
+    // LLVM doesn't care about the order of top-level entities, so it's fine to output functions first in stream mode.
     ostream() << type_decls_.str() << '\n';
     for (auto&& decl : decls_) ostream() << decl << '\n';
     ostream() << func_decls_.str() << '\n';
     ostream() << vars_decls_.str() << '\n';
-    ostream() << func_impls_.str() << '\n';
+    if (!world().flags().stream_ll) ostream() << func_impls_.str() << '\n';
+    ostream() << metadata_.str();
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+    world().VLOG("emitted LLVM in {}ms; peak instruction text: {} bytes", ms.count(), pool_.peak());
+}
+
+/*
+ * profiling
+ */
+
+/// Prepends an increment of the counter for @p lam to @p bb - behind the phis, which go to BB::head.
+/// Each Profile::id gets exactly one counter, so the dumped ids are unique within this module.
+void Emitter::count(BB& bb, Lam* lam) {
+    auto id = Profile::id(lam);
+    if (id.empty()) return; // no way to map the count back to the program
+
+    auto [i, fresh] = id2counter_.emplace(id, counters_.size());
+    auto cnt        = "@thorin.prof." + std::to_string(i->second);
+    auto val        = "%" + lam->unique_name() + ".prof";
+    if (fresh) {
+        counters_.emplace_back(std::move(id));
+        print(vars_decls_, "{} = internal global i64 0\n", cnt);
+    }
+
+    auto& body = bb.body();
+    body.emplace_front(bb.pool->line("store i64 {}.inc, i64* {}", val, cnt));
+    body.emplace_front(bb.pool->line("{}.inc = add i64 {}, 1", val, val));
+    body.emplace_front(bb.pool->line("{} = load i64, i64* {}", val, cnt));
+}
+
+/// Registers a destructor that appends all counters of this module to the file in `THORIN_PROFILE` or `thorin.prof`.
+void Emitter::emit_profile_dump() {
+    declare("i8* @getenv(i8*)");
+    declare("i8* @fopen(i8*, i8*)");
+    declare("i32 @fprintf(i8*, i8*, ...)");
+    declare("i32 @fclose(i8*)");
+
+    auto& os  = vars_decls_;
+    auto cstr = [&](std::string name, std::string_view s) {
+        print(os, "@thorin.prof.{} = private unnamed_addr constant [{} x i8] {}\n", name, s.size() + 1, c_str(s));
+        return fmt("i8* getelementptr inbounds ([{} x i8], [{} x i8]* @thorin.prof.{}, i64 0, i64 0)", s.size() + 1,
+                   s.size() + 1, name);
+    };
+
+    auto env  = cstr("env", "THORIN_PROFILE");
+    auto path = cstr("path", "thorin.prof");
+    auto mode = cstr("mode", "a");
+    auto line = cstr("line", "%llu %s\n");
+    std::vector<std::string> names;
+    for (size_t i = 0, e = counters_.size(); i != e; ++i)
+        names.emplace_back(cstr("name." + std::to_string(i), counters_[i]));
+
+    print(os, "@llvm.global_dtors = appending global [1 x {{ i32, void ()*, i8* }}] "
+              "[{{ i32, void ()*, i8* }} {{ i32 65535, void ()* @thorin.prof.dump, i8* null }}]\n\n");
+    print(os, "define internal void @thorin.prof.dump() {{\n");
+    print(os, "entry:\n");
+    print(os, "    %env = call i8* @getenv({})\n", env);
+    print(os, "    %no_env = icmp eq i8* %env, null\n");
+    print(os, "    %path = select i1 %no_env, {}, i8* %env\n", path);
+    print(os, "    %file = call i8* @fopen(i8* %path, {})\n", mode);
+    print(os, "    %no_file = icmp eq i8* %file, null\n");
+    print(os, "    br i1 %no_file, label %exit, label %dump\n");
+    print(os, "dump:\n");
+    for (size_t i = 0, e = counters_.size(); i != e; ++i) {
+        print(os, "    %cnt.{} = load i64, i64* @thorin.prof.{}\n", i, i);
+        print(os, "    call i32 (i8*, i8*, ...) @fprintf(i8* %file, {}, i64 %cnt.{}, {})\n", line, i, names[i]);
+    }
+    print(os, "    call i32 @fclose(i8* %file)\n");
+    print(os, "    br label %exit\n");
+    print(os, "exit:\n");
+    print(os, "    ret void\n");
+    print(os, "}}\n");
+}
+
+/// Functions are distributed round-robin in the deterministic order in which ScopePhase discovers them.
+/// As every partition discovers all functions in this order, they all agree on the owner of each Global, too.
+void Emitter::visit(const Scope& scope) {
+    if (auto lam = scope.entry()->isa_mut<Lam>(); lam && lam->is_set() && num_partitions_ > 1) {
+        auto partition = num_funs_++ % num_partitions_;
+        for (auto mut : scope.free_muts())
+            if (mut->isa<Global>()) global2partition_.emplace(mut, partition);
+        if (partition != partition_) return emit_imported(lam);
+    }
+    Super::visit(scope);
 }
 
 void Emitter::emit_imported(Lam* lam) {
@@ -262,53 +748,69 @@ void Emitter::emit_imported(Lam* lam) {
 std::string Emitter::prepare(const Scope& scope) {
     auto lam = scope.entry()->as_mut<Lam>();
 
-    print(func_impls_, "define {} {}(", convert_ret_pi(lam->type()->ret_pi()), id(lam));
+    print(impls(), "define {} {}(", convert_ret_pi(lam->type()->ret_pi()), id(lam));
 
     auto vars = lam->vars();
-    for (auto sep = ""; auto var : vars.view().rsubspan(1)) {
+    auto sep  = "";
+    for (size_t i = 0, n = vars.size() - 1; i != n; ++i) {
+        auto var = vars[i];
         if (match<mem::M>(var->type())) continue;
         auto name    = id(var);
+        auto noalias = match<mem::Ptr>(var->type()) && is_noalias(lam, i) ? " noalias" : "";
         locals_[var] = name;
-        print(func_impls_, "{}{} {}", sep, convert(var->type()), name);
+        print(impls(), "{}{}{} {}", sep, convert(var->type()), noalias, name);
         sep = ", ";
     }
 
-    print(func_impls_, ") {{\n");
+    print(impls(), ") {{\n");
     return lam->unique_name();
 }
 
 void Emitter::finalize(const Scope& scope) {
-    for (auto& [lam, bb] : lam2bb_) {
-        for (const auto& [phi, args] : bb.phis) {
-            print(bb.head().emplace_back(), "{} = phi {} ", id(phi), convert(phi->type()));
-            for (auto sep = ""; const auto& [arg, pred] : args) {
-                print(bb.head().back(), "{}[ {}, {} ]", sep, arg, pred);
-                sep = ", ";
-            }
-        }
+    // define the Global%s owned by this partition - even if the code using them turned out to be dead
+    if (num_partitions_ > 1) {
+        for (auto mut : scope.free_muts())
+            if (auto global = mut->isa<Global>(); global && global2partition_[global] == partition_)
+                emit_unsafe(global);
     }
 
+    auto& os = impls();
     for (auto mut : Scheduler::schedule(scope)) {
         if (auto lam = mut->isa_mut<Lam>()) {
             if (lam == scope.exit()) continue;
             assert(lam2bb_.contains(lam));
-            auto& bb = lam2bb_[lam];
-            print(func_impls_, "{}:\n", lam->unique_name());
+            auto& bb = this->bb(lam);
+
+            for (const auto& [phi, args] : bb.phis) {
+                auto& line = print(bb.pool->begin(), "{} = phi {} ", id(phi), convert(phi->type()));
+                for (auto sep = ""; const auto& [arg, pred] : args) {
+                    print(line, "{}[ {}, {} ]", sep, arg, pred);
+                    sep = ", ";
+                }
+                bb.head().emplace_back(bb.pool->end());
+            }
+
+            if (world().flags().instrument) count(bb, lam);
+            print(os, "{}:\n", lam->unique_name());
 
             ++tab;
             for (const auto& part : bb.parts)
-                for (const auto& line : part) tab.print(func_impls_, "{}\n", line.str());
+                for (auto line : part) tab.print(os, "{}\n", line);
             --tab;
-            func_impls_ << std::endl;
+            os << std::endl;
+
+            bb = BB(); // free memory - we won't need this BB anymore
         }
     }
 
-    print(func_impls_, "}}\n\n");
+    print(os, "}}\n\n");
+    pool_.clear();
+    vecs_.clear();
 }
 
 void Emitter::emit_epilogue(Lam* lam) {
     auto app = lam->body()->as<App>();
-    auto& bb = lam2bb_[lam];
+    auto& bb = this->bb(lam);
 
     if (app->callee() == entry_->ret_var()) { // return
         std::vector<std::string> values;
@@ -367,10 +869,13 @@ void Emitter::emit_epilogue(Lam* lam) {
             return bb.tail("br i1 {}, label {}, label {}", c, t, f);
         } else {
             auto t_c = convert(ex->index()->type());
-            bb.tail("switch {} {}, label {} [ ", t_c, c, emit(ex->tuple()->proj(0)));
-            for (auto i = 1u; i < ex->tuple()->num_projs(); i++)
-                print(bb.tail().back(), "{} {}, label {} ", t_c, std::to_string(i), emit(ex->tuple()->proj(i)));
-            print(bb.tail().back(), "]");
+            std::vector<std::string> labels;
+            for (auto i = 0u; i < ex->tuple()->num_projs(); i++) labels.emplace_back(emit(ex->tuple()->proj(i)));
+
+            auto& line = print(bb.pool->begin(), "switch {} {}, label {} [ ", t_c, c, labels[0]);
+            for (auto i = 1u; i < labels.size(); i++) print(line, "{} {}, label {} ", t_c, std::to_string(i), labels[i]);
+            line << "]";
+            bb.tail().emplace_back(bb.pool->end());
         }
     } else if (app->callee()->isa<Bot>()) {
         return bb.tail("ret ; bottom: unreachable");
@@ -384,6 +889,7 @@ void Emitter::emit_epilogue(Lam* lam) {
                 locals_[phi] = id(phi);
             }
         }
+        if (world().flags().loop_hints && is_counted_loop(callee, app)) return bb.tail("br label {}, !llvm.loop {}", id(callee), loop());
         return bb.tail("br label {}", id(callee));
     } else if (auto longjmp = match<clos::longjmp>(app)) {
         declare("void @longjmp(i8*, i32) noreturn");
@@ -447,611 +953,538 @@ void Emitter::emit_epilogue(Lam* lam) {
     }
 }
 
-std::string Emitter::emit_bb(BB& bb, const Def* def) {
-    if (auto lam = def->isa<Lam>()) return id(lam);
+std::string Emitter::emit_tuple(BB& bb, const Def* tuple, const std::string& name) {
+    if (core::isa_mem_sigma_2(tuple->type())) {
+        emit_unsafe(tuple->proj(2, 0));
+        return emit(tuple->proj(2, 1));
+    }
 
-    auto name = id(def);
-    std::string op;
+    if (isa_vec(tuple->type()) && tuple->isa<Tuple>()) {
+        if (auto zip = emit_zip(bb, tuple, name); !zip.empty()) return zip;
+    }
 
-    auto emit_tuple = [&](const Def* tuple) {
-        if (isa_mem_sigma_2(tuple->type())) {
-            emit_unsafe(tuple->proj(2, 0));
-            return emit(tuple->proj(2, 1));
+    if (core::is_const(tuple)) {
+        bool is_array = tuple->type()->isa<Arr>();
+
+        std::string s;
+        s += is_array ? "[" : "{";
+        auto sep = "";
+        for (size_t i = 0, n = tuple->num_projs(); i != n; ++i) {
+            auto e = tuple->proj(n, i);
+            if (auto v_elem = emit_unsafe(e); !v_elem.empty()) {
+                auto t_elem = convert(e->type());
+                s += sep + t_elem + " " + v_elem;
+                sep = ", ";
+            }
         }
 
-        if (is_const(tuple)) {
-            bool is_array = tuple->type()->isa<Arr>();
-
-            std::string s;
-            s += is_array ? "[" : "{";
-            auto sep = "";
-            for (size_t i = 0, n = tuple->num_projs(); i != n; ++i) {
-                auto e = tuple->proj(n, i);
-                if (auto v_elem = emit_unsafe(e); !v_elem.empty()) {
-                    auto t_elem = convert(e->type());
-                    s += sep + t_elem + " " + v_elem;
-                    sep = ", ";
-                }
-            }
+        return s += is_array ? "]" : "}";
+    }
 
-            return s += is_array ? "]" : "}";
+    std::string prev = "undef";
+    auto t           = convert(tuple->type());
+    for (size_t src = 0, dst = 0, n = tuple->num_projs(); src != n; ++src) {
+        auto e = tuple->proj(n, src);
+        if (auto elem = emit_unsafe(e); !elem.empty()) {
+            auto elem_t = convert(e->type());
+            // TODO: check dst vs src
+            auto namei = name + "." + std::to_string(dst);
+            prev       = bb.assign(namei, "insertvalue {} {}, {} {}, {}", t, prev, elem_t, elem, dst);
+            dst++;
         }
+    }
+    return prev;
+}
 
-        std::string prev = "undef";
-        auto t           = convert(tuple->type());
-        for (size_t src = 0, dst = 0, n = tuple->num_projs(); src != n; ++src) {
-            auto e = tuple->proj(n, src);
-            if (auto elem = emit_unsafe(e); !elem.empty()) {
-                auto elem_t = convert(e->type());
-                // TODO: check dst vs src
-                auto namei = name + "." + std::to_string(dst);
-                prev       = bb.assign(namei, "insertvalue {} {}, {} {}, {}", t, prev, elem_t, elem, dst);
-                dst++;
-            }
+/// Emits `(f (a#0, b#0), ..., f (a#n-1, b#n-1))` as a single vector instruction `f a b`, if possible.
+/// @returns the empty string otherwise.
+std::string Emitter::emit_zip(BB& bb, const Def* tuple, const std::string& name) {
+    auto first = tuple->op(0)->isa<App>();
+    if (!first) return {};
+
+    auto f  = first->callee();
+    auto op = isa_binop(f);
+    if (!op) return {};
+
+    std::array<const Def*, 2> vecs = {nullptr, nullptr};
+    for (size_t i = 0, n = tuple->num_ops(); i != n; ++i) {
+        auto app = tuple->op(i)->isa<App>();
+        if (!app || app->callee() != f || app->arg()->num_projs() != 2) return {};
+
+        for (size_t j = 0; j != 2; ++j) {
+            auto extract = app->arg()->proj(2, j)->isa<Extract>();
+            if (!extract || Lit::isa(extract->index()) != i || extract->tuple()->type() != tuple->type()) return {};
+            if (i == 0) vecs[j] = extract->tuple();
+            if (vecs[j] != extract->tuple()) return {};
         }
-        return prev;
-    };
+    }
+
+    auto a   = to_vec(bb, vecs[0], name + ".a");
+    auto b   = to_vec(bb, vecs[1], name + ".b");
+    auto vec = bb.assign(name + ".vec", "{} {} {}, {}", *op, vec_type(tuple->type()), a, b);
+    return from_vec(bb, tuple->type(), vecs_[tuple] = vec, name);
+}
+
+/// Yields the Arr value @p def as vector.
+/// Unless @p def is a constant or its vector is already known, its lanes are moved one by one at the end of @p bb.
+std::string Emitter::to_vec(BB& bb, const Def* def, const std::string& name) {
+    if (auto i = vecs_.find(def); i != vecs_.end()) return i->second;
+
+    auto n = *isa_vec(def->type());
+    auto t = vec_type(def->type());
+    if (core::is_const(def)) {
+        if (auto pack = def->isa<Pack>(); pack && Lit::isa(pack->body()) == 0) return "zeroinitializer";
 
-    if (def->isa<Var>()) {
-        auto ts = def->type()->projs();
-        if (std::ranges::any_of(ts, [](auto t) { return match<mem::M>(t); })) return {};
-        return emit_tuple(def);
+        std::string s = "<";
+        for (auto sep = ""; auto e : def->projs(n)) {
+            s += sep + convert(e->type()) + " " + emit(e);
+            sep = ", ";
+        }
+        return s += ">";
     }
 
-    auto emit_gep_index = [&](const Def* index) {
-        auto v_i = emit(index);
-        auto t_i = convert(index->type());
+    auto v_arr       = emit(def);
+    auto t_arr       = convert(def->type());
+    auto t_elem      = convert(def->type()->as<Arr>()->body());
+    std::string prev = "undef";
+    for (size_t i = 0; i != n; ++i) {
+        auto elem = bb.assign(fmt("{}.e{}", name, i), "extractvalue {} {}, {}", t_arr, v_arr, i);
+        prev      = bb.assign(fmt("{}.v{}", name, i), "insertelement {} {}, {} {}, i64 {}", t, prev, t_elem, elem, i);
+    }
+    return prev;
+}
 
-        if (auto size = Idx::size(index->type())) {
-            if (auto w = Idx::size2bitwidth(size); w && *w < 64) {
-                v_i = bb.assign(name + ".zext",
-                                "zext {} {} to i{} ; add one more bit for gep index as it is treated as signed value",
-                                t_i, v_i, *w + 1);
-                t_i = "i" + std::to_string(*w + 1);
-            }
+/// Yields the vector @p vec as value of Arr @p type.
+std::string Emitter::from_vec(BB& bb, const Def* type, const std::string& vec, const std::string& name) {
+    auto n           = *isa_vec(type);
+    auto t           = vec_type(type);
+    auto t_arr       = convert(type);
+    auto t_elem      = convert(type->as<Arr>()->body());
+    std::string prev = "undef";
+    for (size_t i = 0; i != n; ++i) {
+        auto elem = bb.assign(fmt("{}.x{}", name, i), "extractelement {} {}, i64 {}", t, vec, i);
+        prev      = bb.assign(fmt("{}.{}", name, i), "insertvalue {} {}, {} {}, {}", t_arr, prev, t_elem, elem, i);
+    }
+    return prev;
+}
+
+std::pair<std::string, std::string> Emitter::emit_gep_index(BB& bb, const Def* index, const std::string& name) {
+    auto v_i = emit(index);
+    auto t_i = convert(index->type());
+
+    if (auto size = Idx::size(index->type())) {
+        if (auto w = Idx::size2bitwidth(size); w && *w < 64) {
+            v_i = bb.assign(name + ".zext",
+                            "zext {} {} to i{} ; add one more bit for gep index as it is treated as signed value", t_i,
+                            v_i, *w + 1);
+            t_i = "i" + std::to_string(*w + 1);
         }
+    }
 
-        return std::pair(v_i, t_i);
-    };
+    return {v_i, t_i};
+}
 
-    if (auto lit = def->isa<Lit>()) {
-        if (lit->type()->isa<Nat>() || Idx::size(lit->type())) {
-            return std::to_string(lit->get());
-        } else if (auto w = math::isa_f(lit->type())) {
-            std::stringstream s;
-            u64 hex;
-
-            switch (*w) {
-                case 16:
-                    s << "0xH" << std::setfill('0') << std::setw(4) << std::right << std::hex << lit->get<u16>();
-                    return s.str();
-                case 32: {
-                    hex = std::bit_cast<u64>(f64(lit->get<f32>()));
-                    break;
+std::string Emitter::emit_bb(BB& bb, const Def* def) {
+    if (auto lam = def->isa<Lam>()) return id(lam);
+    bb.pool = &pool_;
+
+    auto name = id(def);
+
+    // fully applied Axiom%s are looked up in constant time instead of trying one Match after the other
+    if (auto [axiom, curry, _] = Axiom::get(def); axiom && curry == 0) {
+        if (auto lower = world().driver().lowering(axiom->base())) {
+            auto prev = std::exchange(bb_, &bb);
+            auto res  = lower(*this, def, name);
+            bb_       = prev;
+            return res;
+        }
+        error("unhandled def in LLVM backend - is its plugin loaded? {} : {}", def, def->type());
+    }
+
+    switch (def->node()) {
+        case Node::Var: {
+            auto ts = def->type()->projs();
+            if (std::ranges::any_of(ts, [](auto t) { return match<mem::M>(t); })) return {};
+            return emit_tuple(bb, def, name);
+        }
+        case Node::Lit: {
+            auto lit = def->as<Lit>();
+            if (lit->type()->isa<Nat>() || Idx::size(lit->type())) {
+                return std::to_string(lit->get());
+            } else if (auto w = math::isa_f(lit->type())) {
+                std::stringstream s;
+                u64 hex;
+
+                switch (*w) {
+                    case 16:
+                        s << "0xH" << std::setfill('0') << std::setw(4) << std::right << std::hex << lit->get<u16>();
+                        return s.str();
+                    case 32: {
+                        hex = std::bit_cast<u64>(f64(lit->get<f32>()));
+                        break;
+                    }
+                    case 64: hex = lit->get<u64>(); break;
+                    default: fe::unreachable();
                 }
-                case 64: hex = lit->get<u64>(); break;
-                default: fe::unreachable();
-            }
 
-            s << "0x" << std::setfill('0') << std::setw(16) << std::right << std::hex << hex;
-            return s.str();
+                s << "0x" << std::setfill('0') << std::setw(16) << std::right << std::hex << hex;
+                return s.str();
+            }
+            fe::unreachable();
         }
-        fe::unreachable();
-    } else if (def->isa<Bot>()) {
-        return "undef";
-    } else if (auto top = def->isa<Top>()) {
-        if (match<mem::M>(top->type())) return {};
-        // bail out to error below
-    } else if (auto tuple = def->isa<Tuple>()) {
-        return emit_tuple(tuple);
-    } else if (auto pack = def->isa<Pack>()) {
-        if (auto lit = Lit::isa(pack->body()); lit && *lit == 0) return "zeroinitializer";
-        return emit_tuple(pack);
-    } else if (auto extract = def->isa<Extract>()) {
-        auto tuple = extract->tuple();
-        auto index = extract->index();
-
-        // use select when extracting from 2-element integral tuples
-        // literal indices would be normalized away already, if it was possible
-        // As they aren't they likely depend on a var, which is implemented as array -> need extractvalue
-        if (auto app = extract->type()->isa<App>();
-            app && app->callee()->isa<Idx>() && !index->isa<Lit>() && tuple->type()->isa<Arr>()) {
-            if (auto arity = tuple->type()->isa_lit_arity(); arity && *arity == 2) {
-                auto t                = convert(extract->type());
-                auto [elem_a, elem_b] = tuple->projs<2>([&](auto e) { return emit_unsafe(e); });
-
-                return bb.assign(name, "select {} {}, {} {}, {} {}", convert(index->type()), emit(index), t, elem_b, t,
-                                 elem_a);
+        case Node::Bot: return "undef";
+        case Node::Top:
+            if (match<mem::M>(def->type())) return {};
+            break; // bail out to error below
+        case Node::Tuple: return emit_tuple(bb, def, name);
+        case Node::Pack: {
+            auto pack = def->as<Pack>();
+            if (auto lit = Lit::isa(pack->body()); lit && *lit == 0) return "zeroinitializer";
+            if (isa_vec(pack->type()) && !core::is_const(pack)) {
+                // splat: insert into lane 0 and broadcast it to all other lanes
+                auto t      = vec_type(pack->type());
+                auto t_elem = convert(pack->body()->type());
+                auto v_elem = emit(pack->body());
+                bb.assign(name + ".ins", "insertelement {} undef, {} {}, i64 0", t, t_elem, v_elem);
+                auto vec = bb.assign(name + ".vec", "shufflevector {} {}.ins, {} undef, <{} x i32> zeroinitializer", t,
+                                     name, t, *isa_vec(pack->type()));
+                return from_vec(bb, pack->type(), vecs_[pack] = vec, name);
             }
+            return emit_tuple(bb, pack, name);
         }
+        case Node::Extract: {
+            auto extract = def->as<Extract>();
+            auto tuple   = extract->tuple();
+            auto index   = extract->index();
+
+            // use select when extracting from 2-element integral tuples
+            // literal indices would be normalized away already, if it was possible
+            // As they aren't they likely depend on a var, which is implemented as array -> need extractvalue
+            if (auto app = extract->type()->isa<App>();
+                app && app->callee()->isa<Idx>() && !index->isa<Lit>() && tuple->type()->isa<Arr>()) {
+                if (auto arity = tuple->type()->isa_lit_arity(); arity && *arity == 2) {
+                    auto t                = convert(extract->type());
+                    auto [elem_a, elem_b] = tuple->projs<2>([&](auto e) { return emit_unsafe(e); });
+
+                    return bb.assign(name, "select {} {}, {} {}, {} {}", convert(index->type()), emit(index), t,
+                                     elem_b, t, elem_a);
+                }
+            }
 
-        auto v_tup = emit_unsafe(tuple);
+            auto v_tup = emit_unsafe(tuple);
 
-        // this exact location is important: after emitting the tuple -> ordering of mem ops
-        // before emitting the index, as it might be a weird value for mem vars.
-        if (match<mem::M>(extract->type())) return {};
+            // this exact location is important: after emitting the tuple -> ordering of mem ops
+            // before emitting the index, as it might be a weird value for mem vars.
+            if (match<mem::M>(extract->type())) return {};
 
-        auto t_tup = convert(tuple->type());
-        if (auto li = Lit::isa(index)) {
-            if (isa_mem_sigma_2(tuple->type())) return v_tup;
-            // Adjust index, if mem is present.
-            auto v_i = match<mem::M>(tuple->proj(0)->type()) ? std::to_string(*li - 1) : std::to_string(*li);
-            return bb.assign(name, "extractvalue {} {}, {}", t_tup, v_tup, v_i);
-        }
+            auto t_tup = convert(tuple->type());
+            if (auto li = Lit::isa(index)) {
+                if (core::isa_mem_sigma_2(tuple->type())) return v_tup;
+                // Adjust index, if mem is present.
+                auto v_i = match<mem::M>(tuple->proj(0)->type()) ? std::to_string(*li - 1) : std::to_string(*li);
+                return bb.assign(name, "extractvalue {} {}, {}", t_tup, v_tup, v_i);
+            }
 
-        auto t_elem     = convert(extract->type());
-        auto [v_i, t_i] = emit_gep_index(index);
-
-        print(lam2bb_[entry_].body().emplace_front(),
-              "{}.alloca = alloca {} ; copy to alloca to emulate extract with store + gep + load", name, t_tup);
-        print(bb.body().emplace_back(), "store {} {}, {}* {}.alloca", t_tup, v_tup, t_tup, name);
-        print(bb.body().emplace_back(), "{}.gep = getelementptr inbounds {}, {}* {}.alloca, i64 0, {} {}", name, t_tup,
-              t_tup, name, t_i, v_i);
-        return bb.assign(name, "load {}, {}* {}.gep", t_elem, t_elem, name);
-    } else if (auto insert = def->isa<Insert>()) {
-        assert(!match<mem::M>(insert->tuple()->proj(0)->type()));
-        auto t_tup = convert(insert->tuple()->type());
-        auto t_val = convert(insert->value()->type());
-        auto v_tup = emit(insert->tuple());
-        auto v_val = emit(insert->value());
-        if (auto idx = Lit::isa(insert->index())) {
-            auto v_idx = emit(insert->index());
-            return bb.assign(name, "insertvalue {} {}, {} {}, {}", t_tup, v_tup, t_val, v_val, v_idx);
-        } else {
-            auto t_elem     = convert(insert->value()->type());
-            auto [v_i, t_i] = emit_gep_index(insert->index());
-            print(lam2bb_[entry_].body().emplace_front(),
-                  "{}.alloca = alloca {} ; copy to alloca to emulate insert with store + gep + load", name, t_tup);
-            print(bb.body().emplace_back(), "store {} {}, {}* {}.alloca", t_tup, v_tup, t_tup, name);
-            print(bb.body().emplace_back(), "{}.gep = getelementptr inbounds {}, {}* {}.alloca, i64 0, {} {}", name,
-                  t_tup, t_tup, name, t_i, v_i);
-            print(bb.body().emplace_back(), "store {} {}, {}* {}.gep", t_val, v_val, t_val, name);
-            return bb.assign(name, "load {}, {}* {}.alloca", t_tup, t_tup, name);
+            if (isa_vec(tuple->type())) {
+                // no need to go through memory: extractelement also accepts a dynamic index
+                auto v_vec = to_vec(bb, tuple, name + ".vec");
+                return bb.assign(name, "extractelement {} {}, {} {}", vec_type(tuple->type()), v_vec,
+                                 convert(index->type()), emit(index));
+            }
+
+            auto t_elem     = convert(extract->type());
+            auto [v_i, t_i] = emit_gep_index(bb, index, name);
+
+            this->bb(entry_).body().emplace_front(pool_.line(
+                "{}.alloca = alloca {} ; copy to alloca to emulate extract with store + gep + load", name, t_tup));
+            bb.body("store {} {}, {}* {}.alloca", t_tup, v_tup, t_tup, name);
+            bb.body("{}.gep = getelementptr inbounds {}, {}* {}.alloca, i64 0, {} {}", name, t_tup, t_tup, name, t_i,
+                    v_i);
+            return bb.assign(name, "load {}, {}* {}.gep", t_elem, t_elem, name);
+        }
+        case Node::Insert: {
+            auto insert = def->as<Insert>();
+            assert(!match<mem::M>(insert->tuple()->proj(0)->type()));
+            auto t_tup = convert(insert->tuple()->type());
+            auto t_val = convert(insert->value()->type());
+            auto v_tup = emit(insert->tuple());
+            auto v_val = emit(insert->value());
+            if (auto idx = Lit::isa(insert->index())) {
+                auto v_idx = emit(insert->index());
+                return bb.assign(name, "insertvalue {} {}, {} {}, {}", t_tup, v_tup, t_val, v_val, v_idx);
+            } else if (auto type = insert->type(); isa_vec(type)) {
+                auto t_idx = convert(insert->index()->type());
+                auto v_idx = emit(insert->index());
+                auto v_vec = to_vec(bb, insert->tuple(), name + ".vec");
+                auto vec   = bb.assign(name + ".ins", "insertelement {} {}, {} {}, {} {}", vec_type(type), v_vec, t_val,
+                                       v_val, t_idx, v_idx);
+                return from_vec(bb, type, vecs_[insert] = vec, name);
+            } else {
+                auto t_elem     = convert(insert->value()->type());
+                auto [v_i, t_i] = emit_gep_index(bb, insert->index(), name);
+                this->bb(entry_).body().emplace_front(pool_.line(
+                    "{}.alloca = alloca {} ; copy to alloca to emulate insert with store + gep + load", name, t_tup));
+                bb.body("store {} {}, {}* {}.alloca", t_tup, v_tup, t_tup, name);
+                bb.body("{}.gep = getelementptr inbounds {}, {}* {}.alloca, i64 0, {} {}", name, t_tup, t_tup, name,
+                        t_i, v_i);
+                bb.body("store {} {}, {}* {}.gep", t_val, v_val, t_val, name);
+                return bb.assign(name, "load {}, {}* {}.alloca", t_tup, t_tup, name);
+            }
         }
-    } else if (auto global = def->isa<Global>()) {
-        auto v_init                = emit(global->init());
-        auto [pointee, addr_space] = force<mem::Ptr>(global->type())->args<2>();
-        print(vars_decls_, "{} = global {} {}\n", name, convert(pointee), v_init);
-        return globals_[global] = name;
-    } else if (auto nat = match<core::nat>(def)) {
-        auto [a, b] = nat->args<2>([this](auto def) { return emit(def); });
-
-        switch (nat.id()) {
-            case core::nat::add: op = "add"; break;
-            case core::nat::sub: op = "sub"; break;
-            case core::nat::mul: op = "mul"; break;
+        case Node::Global: {
+            auto global                = def->as<Global>();
+            auto [pointee, addr_space] = force<mem::Ptr>(global->type())->args<2>();
+            if (num_partitions_ > 1 && global2partition_[global] != partition_)
+                print(vars_decls_, "{} = external global {}\n", name, convert(pointee));
+            else
+                print(vars_decls_, "{} = global {} {}\n", name, convert(pointee), emit(global->init()));
+            return globals_[global] = name;
         }
+        default: break;
+    }
 
-        return bb.assign(name, "{} nsw nuw i64 {}, {}", op, a, b);
-    } else if (auto ncmp = match<core::ncmp>(def)) {
-        auto [a, b] = ncmp->args<2>([this](auto def) { return emit(def); });
-        op          = "icmp ";
+    error("unhandled def in LLVM backend: {} : {}", def, def->type());
+}
 
-        switch (ncmp.id()) {
-            // clang-format off
-            case core::ncmp::e:  op += "eq" ; break;
-            case core::ncmp::ne: op += "ne" ; break;
-            case core::ncmp::g:  op += "ugt"; break;
-            case core::ncmp::ge: op += "uge"; break;
-            case core::ncmp::l:  op += "ult"; break;
-            case core::ncmp::le: op += "ule"; break;
-            // clang-format on
-            default: fe::unreachable();
-        }
+/*
+ * lowerings
+ */
 
-        return bb.assign(name, "{} i64 {}, {}", op, a, b);
-    } else if (auto idx = match<core::idx>(def)) {
-        auto x = emit(idx->arg());
-        auto s = *Idx::size2bitwidth(Idx::size(idx->type()));
-        auto t = convert(idx->type());
-        if (s < 64) return bb.assign(name, "trunc i64 {} to {}", x, t);
-        return x;
-    } else if (auto bit1 = match<core::bit1>(def)) {
-        assert(bit1.id() == core::bit1::neg);
-        auto x = emit(bit1->arg());
-        auto t = convert(bit1->type());
-        return bb.assign(name, "xor {} -1, {}", t, x);
-    } else if (auto bit2 = match<core::bit2>(def)) {
-        auto [a, b] = bit2->args<2>([this](auto def) { return emit(def); });
-        auto t      = convert(bit2->type());
-
-        auto neg = [&](std::string_view x) { return bb.assign(name + ".neg", "xor {} -1, {}", t, x); };
-
-        switch (bit2.id()) {
-            // clang-format off
-            case core::bit2::and_: return bb.assign(name, "and {} {}, {}", t, a, b);
-            case core::bit2:: or_: return bb.assign(name, "or  {} {}, {}", t, a, b);
-            case core::bit2::xor_: return bb.assign(name, "xor {} {}, {}", t, a, b);
-            case core::bit2::nand: return neg(bb.assign(name, "and {} {}, {}", t, a, b));
-            case core::bit2:: nor: return neg(bb.assign(name, "or  {} {}, {}", t, a, b));
-            case core::bit2::nxor: return neg(bb.assign(name, "xor {} {}, {}", t, a, b));
-            case core::bit2:: iff: return bb.assign(name, "and {} {}, {}", neg(a), b);
-            case core::bit2::niff: return bb.assign(name, "or  {} {}, {}", neg(a), b);
-            // clang-format on
-            default: fe::unreachable();
-        }
-    } else if (auto shr = match<core::shr>(def)) {
-        auto [a, b] = shr->args<2>([this](auto def) { return emit(def); });
-        auto t      = convert(shr->type());
+template<> std::string Emitter::lower<core::nat>(BB& bb, const Def* def, const std::string& name) {
+    auto nat = force<core::nat>(def);
+    std::string op;
+    auto [a, b] = nat->args<2>([this](auto def) { return emit(def); });
 
-        switch (shr.id()) {
-            case core::shr::a: op = "ashr"; break;
-            case core::shr::l: op = "lshr"; break;
-        }
+    switch (nat.id()) {
+        case core::nat::add: op = "add"; break;
+        case core::nat::sub: op = "sub"; break;
+        case core::nat::mul: op = "mul"; break;
+    }
 
-        return bb.assign(name, "{} {} {}, {}", op, t, a, b);
-    } else if (auto wrap = match<core::wrap>(def)) {
-        auto [a, b] = wrap->args<2>([this](auto def) { return emit(def); });
-        auto t      = convert(wrap->type());
-        auto mode   = Lit::as(wrap->decurry()->arg());
-
-        switch (wrap.id()) {
-            case core::wrap::add: op = "add"; break;
-            case core::wrap::sub: op = "sub"; break;
-            case core::wrap::mul: op = "mul"; break;
-            case core::wrap::shl: op = "shl"; break;
-        }
+    return bb.assign(name, "{} nsw nuw i64 {}, {}", op, a, b);
+}
 
-        if (mode & core::Mode::nuw) op += " nuw";
-        if (mode & core::Mode::nsw) op += " nsw";
-
-        return bb.assign(name, "{} {} {}, {}", op, t, a, b);
-    } else if (auto div = match<core::div>(def)) {
-        auto [m, xy] = div->args<2>();
-        auto [x, y]  = xy->projs<2>();
-        auto t       = convert(x->type());
-        emit_unsafe(m);
-        auto a = emit(x);
-        auto b = emit(y);
-
-        switch (div.id()) {
-            case core::div::sdiv: op = "sdiv"; break;
-            case core::div::udiv: op = "udiv"; break;
-            case core::div::srem: op = "srem"; break;
-            case core::div::urem: op = "urem"; break;
-        }
+template<> std::string Emitter::lower<core::ncmp>(BB& bb, const Def* def, const std::string& name) {
+    auto ncmp = force<core::ncmp>(def);
+    std::string op;
+    auto [a, b] = ncmp->args<2>([this](auto def) { return emit(def); });
+    op          = "icmp ";
 
-        return bb.assign(name, "{} {} {}, {}", op, t, a, b);
-    } else if (auto icmp = match<core::icmp>(def)) {
-        auto [a, b] = icmp->args<2>([this](auto def) { return emit(def); });
-        auto t      = convert(icmp->arg(0)->type());
-        op          = "icmp ";
+    switch (ncmp.id()) {
+        // clang-format off
+        case core::ncmp::e:  op += "eq" ; break;
+        case core::ncmp::ne: op += "ne" ; break;
+        case core::ncmp::g:  op += "ugt"; break;
+        case core::ncmp::ge: op += "uge"; break;
+        case core::ncmp::l:  op += "ult"; break;
+        case core::ncmp::le: op += "ule"; break;
+        // clang-format on
+        default: fe::unreachable();
+    }
 
-        switch (icmp.id()) {
-            // clang-format off
-            case core::icmp::e:   op += "eq" ; break;
-            case core::icmp::ne:  op += "ne" ; break;
-            case core::icmp::sg:  op += "sgt"; break;
-            case core::icmp::sge: op += "sge"; break;
-            case core::icmp::sl:  op += "slt"; break;
-            case core::icmp::sle: op += "sle"; break;
-            case core::icmp::ug:  op += "ugt"; break;
-            case core::icmp::uge: op += "uge"; break;
-            case core::icmp::ul:  op += "ult"; break;
-            case core::icmp::ule: op += "ule"; break;
-            // clang-format on
-            default: fe::unreachable();
-        }
+    return bb.assign(name, "{} i64 {}, {}", op, a, b);
+}
 
-        return bb.assign(name, "{} {} {}, {}", op, t, a, b);
-    } else if (auto extr = match<core::extrema>(def)) {
-        auto [x, y]   = extr->args<2>();
-        auto t        = convert(x->type());
-        auto a        = emit(x);
-        auto b        = emit(y);
-        std::string f = "llvm.";
-        switch (extr.id()) {
-            case core::extrema::Sm: f += "smin."; break;
-            case core::extrema::SM: f += "smax."; break;
-            case core::extrema::sm: f += "umin."; break;
-            case core::extrema::sM: f += "umax."; break;
-        }
-        f += t;
-        declare("{} @{}({}, {})", t, f, t, t);
-        return bb.assign(name, "tail call {} @{}({} {}, {} {})", t, f, t, a, t, b);
-    } else if (auto abs = match<core::abs>(def)) {
-        auto [m, x]   = abs->args<2>();
-        auto t        = convert(x->type());
-        auto a        = emit(x);
-        std::string f = "llvm.abs." + t;
-        declare("{} @{}({}, {})", t, f, t, "i1");
-        return bb.assign(name, "tail call {} @{}({} {}, {} {})", t, f, t, a, "i1", "1");
-    } else if (auto conv = match<core::conv>(def)) {
-        auto v_src = emit(conv->arg());
-        auto t_src = convert(conv->arg()->type());
-        auto t_dst = convert(conv->type());
-
-        nat_t w_src = *Idx::size2bitwidth(Idx::size(conv->arg()->type()));
-        nat_t w_dst = *Idx::size2bitwidth(Idx::size(conv->type()));
-
-        if (w_src == w_dst) return v_src;
-
-        switch (conv.id()) {
-            case core::conv::s: op = w_src < w_dst ? "sext" : "trunc"; break;
-            case core::conv::u: op = w_src < w_dst ? "zext" : "trunc"; break;
-        }
+template<> std::string Emitter::lower<core::idx>(BB& bb, const Def* def, const std::string& name) {
+    auto idx = force<core::idx>(def);
+    auto x = emit(idx->arg());
+    auto s = *Idx::size2bitwidth(Idx::size(idx->type()));
+    auto t = convert(idx->type());
+    if (s < 64) return bb.assign(name, "trunc i64 {} to {}", x, t);
+    return x;
+}
 
-        return bb.assign(name, "{} {} {} to {}", op, t_src, v_src, t_dst);
-    } else if (auto bitcast = match<core::bitcast>(def)) {
-        auto dst_type_ptr = match<mem::Ptr>(bitcast->type());
-        auto src_type_ptr = match<mem::Ptr>(bitcast->arg()->type());
-        auto v_src        = emit(bitcast->arg());
-        auto t_src        = convert(bitcast->arg()->type());
-        auto t_dst        = convert(bitcast->type());
+template<> std::string Emitter::lower<core::bit1>(BB& bb, const Def* def, const std::string& name) {
+    auto bit1 = force<core::bit1>(def);
+    assert(bit1.id() == core::bit1::neg);
+    auto x = emit(bit1->arg());
+    auto t = convert(bit1->type());
+    return bb.assign(name, "xor {} -1, {}", t, x);
+}
+
+template<> std::string Emitter::lower<core::bit2>(BB& bb, const Def* def, const std::string& name) {
+    auto bit2 = force<core::bit2>(def);
+    auto [a, b] = bit2->args<2>([this](auto def) { return emit(def); });
+    auto t      = convert(bit2->type());
 
-        if (auto lit = Lit::isa(bitcast->arg()); lit && *lit == 0) return "zeroinitializer";
+    auto neg = [&](std::string_view x) { return bb.assign(name + ".neg", "xor {} -1, {}", t, x); };
+
+    switch (bit2.id()) {
         // clang-format off
-        if (src_type_ptr && dst_type_ptr) return bb.assign(name,  "bitcast {} {} to {}", t_src, v_src, t_dst);
-        if (src_type_ptr)                 return bb.assign(name, "ptrtoint {} {} to {}", t_src, v_src, t_dst);
-        if (dst_type_ptr)                 return bb.assign(name, "inttoptr {} {} to {}", t_src, v_src, t_dst);
+        case core::bit2::and_: return bb.assign(name, "and {} {}, {}", t, a, b);
+        case core::bit2:: or_: return bb.assign(name, "or  {} {}, {}", t, a, b);
+        case core::bit2::xor_: return bb.assign(name, "xor {} {}, {}", t, a, b);
+        case core::bit2::nand: return neg(bb.assign(name, "and {} {}, {}", t, a, b));
+        case core::bit2:: nor: return neg(bb.assign(name, "or  {} {}, {}", t, a, b));
+        case core::bit2::nxor: return neg(bb.assign(name, "xor {} {}, {}", t, a, b));
+        case core::bit2:: iff: return bb.assign(name, "and {} {}, {}", neg(a), b);
+        case core::bit2::niff: return bb.assign(name, "or  {} {}, {}", neg(a), b);
         // clang-format on
+        default: fe::unreachable();
+    }
+}
 
-        auto size2width = [&](const Def* type) {
-            if (type->isa<Nat>()) return 64_n;
-            if (auto size = Idx::size(type)) return *Idx::size2bitwidth(size);
-            return 0_n;
-        };
+template<> std::string Emitter::lower<core::shr>(BB& bb, const Def* def, const std::string& name) {
+    auto shr    = force<core::shr>(def);
+    auto [a, b] = shr->args<2>([this](auto def) { return emit(def); });
+    return bb.assign(name, "{} {} {}, {}", *isa_binop(shr->callee()), convert(shr->type()), a, b);
+}
 
-        auto src_size = size2width(bitcast->arg()->type());
-        auto dst_size = size2width(bitcast->type());
+template<> std::string Emitter::lower<core::wrap>(BB& bb, const Def* def, const std::string& name) {
+    auto wrap   = force<core::wrap>(def);
+    auto [a, b] = wrap->args<2>([this](auto def) { return emit(def); });
+    return bb.assign(name, "{} {} {}, {}", *isa_binop(wrap->callee()), convert(wrap->type()), a, b);
+}
 
-        op = "bitcast";
-        if (src_size && dst_size) {
-            if (src_size == dst_size) return v_src;
-            op = (src_size < dst_size) ? "zext" : "trunc";
-        }
-        return bb.assign(name, "{} {} {} to {}", op, t_src, v_src, t_dst);
-    } else if (auto lea = match<mem::lea>(def)) {
-        auto [ptr, i]  = lea->args<2>();
-        auto pointee   = force<mem::Ptr>(ptr->type())->arg(0);
-        auto v_ptr     = emit(ptr);
-        auto t_pointee = convert(pointee);
-        auto t_ptr     = convert(ptr->type());
-        if (pointee->isa<Sigma>())
-            return bb.assign(name, "getelementptr inbounds {}, {} {}, i64 0, i32 {}", t_pointee, t_ptr, v_ptr,
-                             Lit::as(i));
-
-        assert(pointee->isa<Arr>());
-        auto [v_i, t_i] = emit_gep_index(i);
-
-        return bb.assign(name, "getelementptr inbounds {}, {} {}, i64 0, {} {}", t_pointee, t_ptr, v_ptr, t_i, v_i);
-    } else if (auto malloc = match<mem::malloc>(def)) {
-        declare("i8* @malloc(i64)");
-
-        emit_unsafe(malloc->arg(0));
-        auto size  = emit(malloc->arg(1));
-        auto ptr_t = convert(force<mem::Ptr>(def->proj(1)->type()));
-        bb.assign(name + ".i8", "call i8* @malloc(i64 {})", size);
-        return bb.assign(name, "bitcast i8* {} to {}", name + ".i8", ptr_t);
-    } else if (auto free = match<mem::free>(def)) {
-        declare("void @free(i8*)");
-        emit_unsafe(free->arg(0));
-        auto ptr   = emit(free->arg(1));
-        auto ptr_t = convert(force<mem::Ptr>(free->arg(1)->type()));
-
-        bb.assign(name + ".i8", "bitcast {} {} to i8*", ptr_t, ptr);
-        bb.tail("call void @free(i8* {})", name + ".i8");
-        return {};
-    } else if (auto mslot = match<mem::mslot>(def)) {
-        emit_unsafe(mslot->arg(0));
-        // TODO array with size
-        // auto v_size = emit(mslot->arg(1));
-        auto [pointee, addr_space] = mslot->decurry()->args<2>();
-        print(bb.body().emplace_back(), "{} = alloca {}", name, convert(pointee));
-        return name;
-    } else if (auto free = match<mem::free>(def)) {
-        declare("void @free(i8*)");
-
-        emit_unsafe(free->arg(0));
-        auto v_ptr = emit(free->arg(1));
-        auto t_ptr = convert(force<mem::Ptr>(free->arg(1)->type()));
-
-        bb.assign(name + ".i8", "bitcast {} {} to i8*", t_ptr, v_ptr);
-        bb.tail("call void @free(i8* {})", name + ".i8");
-        return {};
-    } else if (auto load = match<mem::load>(def)) {
-        emit_unsafe(load->arg(0));
-        auto v_ptr     = emit(load->arg(1));
-        auto t_ptr     = convert(load->arg(1)->type());
-        auto t_pointee = convert(force<mem::Ptr>(load->arg(1)->type())->arg(0));
-        return bb.assign(name, "load {}, {} {}", t_pointee, t_ptr, v_ptr);
-    } else if (auto store = match<mem::store>(def)) {
-        emit_unsafe(store->arg(0));
-        auto v_ptr = emit(store->arg(1));
-        auto v_val = emit(store->arg(2));
-        auto t_ptr = convert(store->arg(1)->type());
-        auto t_val = convert(store->arg(2)->type());
-        print(bb.body().emplace_back(), "store {} {}, {} {}", t_val, v_val, t_ptr, v_ptr);
-        return {};
-    } else if (auto q = match<clos::alloc_jmpbuf>(def)) {
-        declare("i64 @jmpbuf_size()");
-
-        emit_unsafe(q->arg());
-        auto size = name + ".size";
-        bb.assign(size, "call i64 @jmpbuf_size()");
-        return bb.assign(name, "alloca i8, i64 {}", size);
-    } else if (auto setjmp = match<clos::setjmp>(def)) {
-        declare("i32 @_setjmp(i8*) returns_twice");
-
-        auto [mem, jmpbuf] = setjmp->arg()->projs<2>();
-        emit_unsafe(mem);
-        auto v_jb = emit(jmpbuf);
-        return bb.assign(name, "call i32 @_setjmp(i8* {})", v_jb);
-    } else if (auto arith = match<math::arith>(def)) {
-        auto [a, b] = arith->args<2>([this](auto def) { return emit(def); });
-        auto t      = convert(arith->type());
-        auto mode   = Lit::as(arith->decurry()->arg());
-
-        switch (arith.id()) {
-            case math::arith::add: op = "fadd"; break;
-            case math::arith::sub: op = "fsub"; break;
-            case math::arith::mul: op = "fmul"; break;
-            case math::arith::div: op = "fdiv"; break;
-            case math::arith::rem: op = "frem"; break;
-        }
+template<> std::string Emitter::lower<core::div>(BB& bb, const Def* def, const std::string& name) {
+    auto div = force<core::div>(def);
+    std::string op;
+    auto [m, xy] = div->args<2>();
+    auto [x, y]  = xy->projs<2>();
+    auto t       = convert(x->type());
+    emit_unsafe(m);
+    auto a = emit(x);
+    auto b = emit(y);
+
+    switch (div.id()) {
+        case core::div::sdiv: op = "sdiv"; break;
+        case core::div::udiv: op = "udiv"; break;
+        case core::div::srem: op = "srem"; break;
+        case core::div::urem: op = "urem"; break;
+    }
 
-        if (mode == math::Mode::fast)
-            op += " fast";
-        else {
-            // clang-format off
-            if (mode & math::Mode::nnan    ) op += " nnan";
-            if (mode & math::Mode::ninf    ) op += " ninf";
-            if (mode & math::Mode::nsz     ) op += " nsz";
-            if (mode & math::Mode::arcp    ) op += " arcp";
-            if (mode & math::Mode::contract) op += " contract";
-            if (mode & math::Mode::afn     ) op += " afn";
-            if (mode & math::Mode::reassoc ) op += " reassoc";
-            // clang-format on
-        }
+    return bb.assign(name, "{} {} {}, {}", op, t, a, b);
+}
 
-        return bb.assign(name, "{} {} {}, {}", op, t, a, b);
-    } else if (auto tri = match<math::tri>(def)) {
-        auto a = emit(tri->arg());
-        auto t = convert(tri->type());
+template<> std::string Emitter::lower<core::icmp>(BB& bb, const Def* def, const std::string& name) {
+    auto icmp = force<core::icmp>(def);
+    std::string op;
+    auto [a, b] = icmp->args<2>([this](auto def) { return emit(def); });
+    auto t      = convert(icmp->arg(0)->type());
+    op          = "icmp ";
 
-        std::string f;
+    switch (icmp.id()) {
+        // clang-format off
+        case core::icmp::e:   op += "eq" ; break;
+        case core::icmp::ne:  op += "ne" ; break;
+        case core::icmp::sg:  op += "sgt"; break;
+        case core::icmp::sge: op += "sge"; break;
+        case core::icmp::sl:  op += "slt"; break;
+        case core::icmp::sle: op += "sle"; break;
+        case core::icmp::ug:  op += "ugt"; break;
+        case core::icmp::uge: op += "uge"; break;
+        case core::icmp::ul:  op += "ult"; break;
+        case core::icmp::ule: op += "ule"; break;
+        // clang-format on
+        default: fe::unreachable();
+    }
 
-        if (tri.id() == math::tri::sin) {
-            f = "llvm.sin"s + llvm_suffix(tri->type());
-        } else if (tri.id() == math::tri::cos) {
-            f = "llvm.cos"s + llvm_suffix(tri->type());
-        } else {
-            if (tri.sub() & sub_t(math::tri::a)) f += "a";
-
-            switch (math::tri((tri.id() & 0x3) | Annex::Base<math::tri>)) {
-                case math::tri::sin: f += "sin"; break;
-                case math::tri::cos: f += "cos"; break;
-                case math::tri::tan: f += "tan"; break;
-                case math::tri::ahFF: error("this axiom is supposed to be unused");
-                default: fe::unreachable();
-            }
+    return bb.assign(name, "{} {} {}, {}", op, t, a, b);
+}
 
-            if (tri.sub() & sub_t(math::tri::h)) f += "h";
-            f += math_suffix(tri->type());
-        }
+template<> std::string Emitter::lower<core::extrema>(BB& bb, const Def* def, const std::string& name) {
+    auto extr = force<core::extrema>(def);
+    auto [x, y]   = extr->args<2>();
+    auto t        = convert(x->type());
+    auto a        = emit(x);
+    auto b        = emit(y);
+    std::string f = "llvm.";
+    switch (extr.id()) {
+        case core::extrema::Sm: f += "smin."; break;
+        case core::extrema::SM: f += "smax."; break;
+        case core::extrema::sm: f += "umin."; break;
+        case core::extrema::sM: f += "umax."; break;
+    }
+    f += t;
+    declare("{} @{}({}, {})", t, f, t, t);
+    return bb.assign(name, "tail call {} @{}({} {}, {} {})", t, f, t, a, t, b);
+}
 
-        declare("{} @{}({})", t, f, t);
-        return bb.assign(name, "tail call {} @{}({} {})", t, f, t, a);
-    } else if (auto extrema = match<math::extrema>(def)) {
-        auto [a, b]   = extrema->args<2>([this](auto def) { return emit(def); });
-        auto t        = convert(extrema->type());
-        std::string f = "llvm.";
-        switch (extrema.id()) {
-            case math::extrema::fmin: f += "minnum"; break;
-            case math::extrema::fmax: f += "maxnum"; break;
-            case math::extrema::ieee754min: f += "minimum"; break;
-            case math::extrema::ieee754max: f += "maximum"; break;
-        }
-        f += llvm_suffix(extrema->type());
-
-        declare("{} @{}({}, {})", t, f, t, t);
-        return bb.assign(name, "tail call {} @{}({} {}, {} {})", t, f, t, a, t, b);
-    } else if (auto pow = match<math::pow>(def)) {
-        auto [a, b]   = pow->args<2>([this](auto def) { return emit(def); });
-        auto t        = convert(pow->type());
-        std::string f = "llvm.pow";
-        f += llvm_suffix(pow->type());
-        declare("{} @{}({}, {})", t, f, t, t);
-        return bb.assign(name, "tail call {} @{}({} {}, {} {})", t, f, t, a, t, b);
-    } else if (auto rt = match<math::rt>(def)) {
-        auto a = emit(rt->arg());
-        auto t = convert(rt->type());
-        std::string f;
-        if (rt.id() == math::rt::sq)
-            f = "llvm.sqrt"s + llvm_suffix(rt->type());
-        else
-            f = "cbrt"s += math_suffix(rt->type());
-        declare("{} @{}({})", t, f, t);
-        return bb.assign(name, "tail call {} @{}({} {})", t, f, t, a);
-    } else if (auto exp = match<math::exp>(def)) {
-        auto a        = emit(exp->arg());
-        auto t        = convert(exp->type());
-        std::string f = "llvm.";
-        f += (exp.sub() & sub_t(math::exp::log)) ? "log" : "exp";
-        f += (exp.sub() & sub_t(math::exp::bin)) ? "2" : (exp.sub() & sub_t(math::exp::dec)) ? "10" : "";
-        f += llvm_suffix(exp->type());
-        // TODO doesn't work for exp10"
-        declare("{} @{}({})", t, f, t);
-        return bb.assign(name, "tail call {} @{}({} {})", t, f, t, a);
-    } else if (auto er = match<math::er>(def)) {
-        auto a = emit(er->arg());
-        auto t = convert(er->type());
-        auto f = er.id() == math::er::f ? "erf"s : "erfc"s;
-        f += math_suffix(er->type());
-        declare("{} @{}({})", t, f, t);
-        return bb.assign(name, "tail call {} @{}({} {})", t, f, t, a);
-    } else if (auto gamma = match<math::gamma>(def)) {
-        auto a        = emit(gamma->arg());
-        auto t        = convert(gamma->type());
-        std::string f = gamma.id() == math::gamma::t ? "tgamma" : "lgamma";
-        f += math_suffix(gamma->type());
-        declare("{} @{}({})", t, f, t);
-        return bb.assign(name, "tail call {} @{}({} {})", t, f, t, a);
-    } else if (auto cmp = match<math::cmp>(def)) {
-        auto [a, b] = cmp->args<2>([this](auto def) { return emit(def); });
-        auto t      = convert(cmp->arg(0)->type());
-        op          = "fcmp ";
-
-        switch (cmp.id()) {
-            // clang-format off
-            case math::cmp::  e: op += "oeq"; break;
-            case math::cmp::  l: op += "olt"; break;
-            case math::cmp:: le: op += "ole"; break;
-            case math::cmp::  g: op += "ogt"; break;
-            case math::cmp:: ge: op += "oge"; break;
-            case math::cmp:: ne: op += "one"; break;
-            case math::cmp::  o: op += "ord"; break;
-            case math::cmp::  u: op += "uno"; break;
-            case math::cmp:: ue: op += "ueq"; break;
-            case math::cmp:: ul: op += "ult"; break;
-            case math::cmp::ule: op += "ule"; break;
-            case math::cmp:: ug: op += "ugt"; break;
-            case math::cmp::uge: op += "uge"; break;
-            case math::cmp::une: op += "une"; break;
-            // clang-format on
-            default: fe::unreachable();
-        }
+template<> std::string Emitter::lower<core::abs>(BB& bb, const Def* def, const std::string& name) {
+    auto abs = force<core::abs>(def);
+    auto [m, x]   = abs->args<2>();
+    auto t        = convert(x->type());
+    auto a        = emit(x);
+    std::string f = "llvm.abs." + t;
+    declare("{} @{}({}, {})", t, f, t, "i1");
+    return bb.assign(name, "tail call {} @{}({} {}, {} {})", t, f, t, a, "i1", "1");
+}
 
-        return bb.assign(name, "{} {} {}, {}", op, t, a, b);
-    } else if (auto conv = match<math::conv>(def)) {
-        auto v_src = emit(conv->arg());
-        auto t_src = convert(conv->arg()->type());
-        auto t_dst = convert(conv->type());
-
-        auto s_src = math::isa_f(conv->arg()->type());
-        auto s_dst = math::isa_f(conv->type());
-
-        switch (conv.id()) {
-            case math::conv::f2f: op = s_src < s_dst ? "fpext" : "fptrunc"; break;
-            case math::conv::s2f: op = "sitofp"; break;
-            case math::conv::u2f: op = "uitofp"; break;
-            case math::conv::f2s: op = "fptosi"; break;
-            case math::conv::f2u: op = "fptoui"; break;
-        }
+template<> std::string Emitter::lower<core::conv>(BB& bb, const Def* def, const std::string& name) {
+    auto conv = force<core::conv>(def);
+    std::string op;
+    auto v_src = emit(conv->arg());
+    auto t_src = convert(conv->arg()->type());
+    auto t_dst = convert(conv->type());
 
-        return bb.assign(name, "{} {} {} to {}", op, t_src, v_src, t_dst);
-    } else if (auto abs = match<math::abs>(def)) {
-        auto a        = emit(abs->arg());
-        auto t        = convert(abs->type());
-        std::string f = "llvm.fabs";
-        f += llvm_suffix(abs->type());
-        declare("{} @{}({})", t, f, t);
-        return bb.assign(name, "tail call {} @{}({} {})", t, f, t, a);
-    } else if (auto round = match<math::round>(def)) {
-        auto a        = emit(round->arg());
-        auto t        = convert(round->type());
-        std::string f = "llvm.";
-        switch (round.id()) {
-            case math::round::f: f += "floor"; break;
-            case math::round::c: f += "ceil"; break;
-            case math::round::r: f += "round"; break;
-            case math::round::t: f += "trunc"; break;
-        }
-        f += llvm_suffix(round->type());
-        declare("{} @{}({})", t, f, t);
-        return bb.assign(name, "tail call {} @{}({} {})", t, f, t, a);
+    nat_t w_src = *Idx::size2bitwidth(Idx::size(conv->arg()->type()));
+    nat_t w_dst = *Idx::size2bitwidth(Idx::size(conv->type()));
+
+    if (w_src == w_dst) return v_src;
+
+    switch (conv.id()) {
+        case core::conv::s: op = w_src < w_dst ? "sext" : "trunc"; break;
+        case core::conv::u: op = w_src < w_dst ? "zext" : "trunc"; break;
     }
-    error("unhandled def in LLVM backend: {} : {}", def, def->type());
+
+    return bb.assign(name, "{} {} {} to {}", op, t_src, v_src, t_dst);
+}
+
+template<> std::string Emitter::lower<core::bitcast>(BB& bb, const Def* def, const std::string& name) {
+    auto bitcast = force<core::bitcast>(def);
+    std::string op;
+    auto dst_type_ptr = match<mem::Ptr>(bitcast->type());
+    auto src_type_ptr = match<mem::Ptr>(bitcast->arg()->type());
+    auto v_src        = emit(bitcast->arg());
+    auto t_src        = convert(bitcast->arg()->type());
+    auto t_dst        = convert(bitcast->type());
+
+    if (auto lit = Lit::isa(bitcast->arg()); lit && *lit == 0) return "zeroinitializer";
+    // clang-format off
+    if (src_type_ptr && dst_type_ptr) return bb.assign(name,  "bitcast {} {} to {}", t_src, v_src, t_dst);
+    if (src_type_ptr)                 return bb.assign(name, "ptrtoint {} {} to {}", t_src, v_src, t_dst);
+    if (dst_type_ptr)                 return bb.assign(name, "inttoptr {} {} to {}", t_src, v_src, t_dst);
+    // clang-format on
+
+    auto size2width = [&](const Def* type) {
+        if (type->isa<Nat>()) return 64_n;
+        if (auto size = Idx::size(type)) return *Idx::size2bitwidth(size);
+        return 0_n;
+    };
+
+    auto src_size = size2width(bitcast->arg()->type());
+    auto dst_size = size2width(bitcast->type());
+
+    op = "bitcast";
+    if (src_size && dst_size) {
+        if (src_size == dst_size) return v_src;
+        op = (src_size < dst_size) ? "zext" : "trunc";
+    }
+    return bb.assign(name, "{} {} {} to {}", op, t_src, v_src, t_dst);
+}
+
+/// Only the element-wise application of a binary operation on vectors is supported;
+/// other instances have to be lowered to loops beforehand.
+template<> std::string Emitter::lower<core::zip>(BB& bb, const Def* def, const std::string& name) {
+    auto zip    = force<core::zip>(def);
+    auto callee = zip->decurry(); // %core.zip (r, s) (n_i, Is, n_o, Os, f)
+    auto r      = Lit::isa(callee->decurry()->arg(0));
+    auto n_i    = Lit::isa(callee->arg(0));
+    auto n_o    = Lit::isa(callee->arg(2));
+    auto op     = isa_binop(callee->arg(4));
+
+    if (!op || r != 1 || n_i != 2 || n_o != 1 || !isa_vec(zip->type()))
+        error("LLVM backend can only emit %core.zip of element-wise binary operations on vectors: {}", def);
+
+    auto a   = to_vec(bb, zip->arg(0), name + ".a");
+    auto b   = to_vec(bb, zip->arg(1), name + ".b");
+    auto vec = bb.assign(name + ".vec", "{} {} {}, {}", *op, vec_type(zip->type()), a, b);
+    return from_vec(bb, zip->type(), vecs_[def] = vec, name);
+}
+
+void register_lowerings(Lowerings& lowerings) {
+    Emitter::add<core::nat, core::ncmp, core::idx, core::bit1, core::bit2, core::shr, core::wrap, core::div, core::icmp,
+                 core::extrema, core::abs, core::conv, core::bitcast, core::zip>(lowerings);
 }
 
 void emit(World& world, std::ostream& ostream) {
@@ -1059,13 +1492,50 @@ void emit(World& world, std::ostream& ostream) {
     emitter.run();
 }
 
-int compile(World& world, std::string name) {
+void emit(World& world, std::ostream& ostream, size_t partition, size_t num_partitions) {
+    Emitter emitter(world, ostream, partition, num_partitions);
+    emitter.run();
+}
+
+int compile(World& world, std::string name, size_t num_partitions) {
 #ifdef _WIN32
     auto exe = name + ".exe"s;
 #else
     auto exe = name;
 #endif
-    return compile(world, name + ".ll"s, exe);
+    if (num_partitions <= 1) return compile(world, name + ".ll"s, exe);
+
+    using Clock = std::chrono::steady_clock;
+    auto begin  = Clock::now();
+    auto ms     = [&] { return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - begin).count(); };
+
+    std::vector<std::string> objs;
+    for (size_t i = 0; i != num_partitions; ++i) {
+        std::ofstream ofs(fmt("{}.{}.ll", name, i));
+        emit(world, ofs, i, num_partitions);
+        objs.emplace_back(fmt("{}.{}.o", name, i));
+    }
+    world.VLOG("emitted {} LLVM partitions in {}ms", num_partitions, ms());
+
+    begin = Clock::now();
+    std::vector<int> res(num_partitions);
+    {
+        std::vector<std::jthread> clangs;
+        for (size_t i = 0; i != num_partitions; ++i)
+            clangs.emplace_back([&, i] {
+                res[i] = sys::system(fmt("clang -c \"{}.{}.ll\" -o \"{}\" -Wno-override-module", name, i, objs[i]));
+            });
+    }
+    world.VLOG("compiled {} LLVM partitions in parallel in {}ms", num_partitions, ms());
+    for (auto r : res)
+        if (r != 0) return r;
+
+    begin           = Clock::now();
+    std::string cmd = "clang";
+    for (const auto& obj : objs) cmd += fmt(" \"{}\"", obj);
+    auto r = sys::system(cmd + fmt(" -o \"{}\"", exe));
+    world.VLOG("linked {} LLVM partitions in {}ms", num_partitions, ms());
+    return r;
 }
 
 int compile(World& world, std::string ll, std::string out) {
@@ -1081,4 +1551,17 @@ int compile_and_run(World& world, std::string name, std::string args) {
     error("compilation failed");
 }
 
+void emit_exe(World& world, std::ostream& ostream) {
+    auto dir = fs::temp_directory_path() / fmt("thorin.{}.{}", world.name(), std::random_device()());
+    fs::create_directories(dir);
+    auto name = (dir / world.name().str()).string();
+    auto res  = compile(world, name, world.flags().ll_partitions);
+#ifdef _WIN32
+    name += ".exe"s;
+#endif
+    if (res == 0) ostream << std::ifstream(name, std::ios::binary).rdbuf();
+    fs::remove_all(dir);
+    if (res != 0) error("compilation failed");
+}
+
 } // namespace thorin::ll
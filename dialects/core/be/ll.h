@@ -2,17 +2,40 @@
 
 #include <ostream>
 
+#include "thorin/plugin.h"
+
 namespace thorin {
 
 class World;
 
 namespace ll {
 
+/// Registers the rules that lower the Axiom%s of the core Plugin to LLVM IR; see Plugin::register_lowerings.
+void register_lowerings(Lowerings&);
+
 void emit(World&, std::ostream&);
+/// Emits only the functions of @p partition (out of @p num_partitions) and declares the remaining ones.
+void emit(World&, std::ostream&, size_t partition, size_t num_partitions);
 
-int compile(World&, std::string name);
+/// If @p num_partitions `> 1`, the module is split into as many `.ll` files that are compiled by parallel `clang`
+/// invocations and linked afterwards.
+int compile(World&, std::string name, size_t num_partitions = 1);
 int compile(World&, std::string ll, std::string out);
 int compile_and_run(World&, std::string name, std::string args = {});
+/// Compiles @p world - split into Flags::ll_partitions modules - with `clang` and writes the executable to @p ostream.
+void emit_exe(World&, std::ostream&);
+
+/// @name In-process LLVM
+/// Only available if Thorin has been built with `THORIN_ENABLE_LLVM`.
+///@{
+/// Builds the module via ll::in_process::emit, runs LLVM's `-O2` pipeline and emits a native object file - all in-process.
+void emit_obj(World&, std::ostream&);
+/// JIT-compiles @p world with LLVM's ORC and invokes its `main` external.
+/// The object code is kept for the lifetime of the process and - if there is a Driver::cache - persisted on disk:
+/// Rerunning a structurally identical World skips LLVM altogether.
+int jit(World&, int argc, char** argv);
+void run(World&, std::ostream&); ///< Runs ll::jit without arguments and writes the exit code of `main`.
+///@}
 
 } // namespace ll
 } // namespace thorin
@@ -0,0 +1,56 @@
+#include "dialects/core/be/llvm.h"
+
+#include <sstream>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "thorin/world.h"
+
+#include "dialects/core/be/ll.h"
+
+namespace thorin::ll::in_process {
+
+void init() {
+    static bool init = [] {
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+        llvm::InitializeNativeTargetAsmParser();
+        return true;
+    }();
+    (void)init;
+}
+
+std::unique_ptr<llvm::Module> emit(World& world, llvm::LLVMContext& context) {
+    std::ostringstream text;
+    ll::emit(world, text);
+
+    llvm::SMDiagnostic diag;
+    auto module = llvm::parseAssemblyString(text.str(), diag, context);
+    if (!module) {
+        std::string msg;
+        llvm::raw_string_ostream os(msg);
+        diag.print(world.name().str().c_str(), os);
+        error("LLVM rejected the emitted IR: {}", os.str());
+    }
+    return module;
+}
+
+void optimize(llvm::Module& module, llvm::TargetMachine* machine) {
+    llvm::LoopAnalysisManager lam;
+    llvm::FunctionAnalysisManager fam;
+    llvm::CGSCCAnalysisManager cgam;
+    llvm::ModuleAnalysisManager mam;
+    llvm::PassBuilder pb(machine);
+    pb.registerModuleAnalyses(mam);
+    pb.registerCGSCCAnalyses(cgam);
+    pb.registerFunctionAnalyses(fam);
+    pb.registerLoopAnalyses(lam);
+    pb.crossRegisterProxies(lam, fam, cgam, mam);
+    pb.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2).run(module, mam);
+}
+
+} // namespace thorin::ll::in_process
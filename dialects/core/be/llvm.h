@@ -0,0 +1,25 @@
+#pragma once
+
+#include <memory>
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
+
+namespace thorin {
+
+class World;
+
+/// Helpers shared by the in-process LLVM backends; only available with `THORIN_ENABLE_LLVM`.
+namespace ll::in_process {
+
+void init(); ///< Initializes the native target once.
+/// Builds @p world as `llvm::Module` living in @p context.
+/// The textual backend ll::emit remains the one instruction selection - Plugin lowerings and metadata included.
+/// Its output is parsed in-process: Neither a temporary `.ll` file nor `clang` is involved.
+std::unique_ptr<llvm::Module> emit(World& world, llvm::LLVMContext& context);
+/// Runs LLVM's `-O2` pipeline tuned for @p machine on @p module.
+void optimize(llvm::Module& module, llvm::TargetMachine* machine);
+
+} // namespace ll::in_process
+} // namespace thorin
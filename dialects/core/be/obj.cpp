@@ -0,0 +1,67 @@
+#include <chrono>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Module.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Target/TargetOptions.h>
+
+#include "thorin/world.h"
+
+#include "dialects/core/be/ll.h"
+#include "dialects/core/be/llvm.h"
+
+using namespace std::string_literals;
+
+namespace thorin::ll {
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+long long ms_since(Clock::time_point begin) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - begin).count();
+}
+} // namespace
+
+void emit_obj(World& world, std::ostream& ostream) {
+    in_process::init();
+    auto begin = Clock::now();
+    llvm::LLVMContext context;
+    auto module = in_process::emit(world, context);
+    auto t_emit = ms_since(begin);
+
+    auto triple = llvm::sys::getDefaultTargetTriple();
+    std::string err;
+    auto target = llvm::TargetRegistry::lookupTarget(triple, err);
+    if (!target) error("no LLVM target for '{}': {}", triple, err);
+
+    llvm::TargetOptions options;
+    auto machine = std::unique_ptr<llvm::TargetMachine>(target->createTargetMachine(
+        triple, llvm::sys::getHostCPUName(), "", options, llvm::Reloc::PIC_, {}, llvm::CodeGenOpt::Aggressive));
+    module->setTargetTriple(triple);
+    module->setDataLayout(machine->createDataLayout());
+
+    begin = Clock::now();
+    in_process::optimize(*module, machine.get());
+    auto t_opt = ms_since(begin);
+
+    begin = Clock::now();
+    llvm::SmallVector<char, 0> obj;
+    {
+        llvm::raw_svector_ostream os(obj);
+        llvm::legacy::PassManager pm;
+        if (machine->addPassesToEmitFile(pm, os, nullptr, llvm::CGFT_ObjectFile))
+            error("LLVM target '{}' can't emit object files", triple);
+        pm.run(*module);
+    }
+    auto t_codegen = ms_since(begin);
+
+    ostream.write(obj.data(), obj.size());
+    world.VLOG("in-process LLVM: emit {}ms, opt {}ms, codegen {}ms", t_emit, t_opt, t_codegen);
+}
+
+} // namespace thorin::ll
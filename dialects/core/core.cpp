@@ -3,13 +3,23 @@
 #include <thorin/config.h>
 #include <thorin/pass/pass.h>
 
+#include "dialects/core/be/c.h"
 #include "dialects/core/be/ll.h"
 
 using namespace thorin;
 
 extern "C" THORIN_EXPORT Plugin thorin_get_plugin() {
     return {"core", [](Normalizers& normalizers) { core::register_normalizers(normalizers); }, nullptr,
-            [](Backends& backends) { backends["ll"] = &ll::emit; }};
+            [](Backends& backends) {
+                backends["c"]   = &c::emit;
+                backends["exe"] = &ll::emit_exe;
+                backends["ll"]  = &ll::emit;
+#ifdef THORIN_ENABLE_LLVM
+                backends["obj"] = &ll::emit_obj;
+                backends["run"] = &ll::run;
+#endif
+            },
+            [](Lowerings& lowerings) { ll::register_lowerings(lowerings); }};
 }
 
 namespace thorin::core {
@@ -8,5 +8,6 @@ using namespace thorin;
 /// Heart of this Plugin.
 /// Registers Pass%es in the different optimization Phase%s as well as normalizers for the Axiom%s.
 extern "C" THORIN_EXPORT Plugin thorin_get_plugin() {
-    return {"demo", [](Normalizers& normalizers) { demo::register_normalizers(normalizers); }, nullptr, nullptr};
+    return {"demo", [](Normalizers& normalizers) { demo::register_normalizers(normalizers); }, nullptr, nullptr,
+            nullptr};
 }
@@ -14,5 +14,5 @@ extern "C" THORIN_EXPORT Plugin thorin_get_plugin() {
                 register_pass<direct::ds2cps_pass, direct::DS2CPS>(passes);
                 register_pass<direct::cps2ds_pass, direct::CPS2DS>(passes);
             },
-            nullptr};
+            nullptr, nullptr};
 }
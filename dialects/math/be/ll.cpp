@@ -0,0 +1,224 @@
+#include "dialects/math/be/ll.h"
+
+#include <thorin/be/ll/lowerer.h>
+
+#include "dialects/core/be/helper.h"
+#include "dialects/math/math.h"
+
+using namespace std::string_literals;
+
+namespace thorin::math {
+
+namespace {
+
+const char* llvm_suffix(const Def* type) {
+    if (auto w = math::isa_f(type)) {
+        switch (*w) {
+            case 16: return ".f16";
+            case 32: return ".f32";
+            case 64: return ".f64";
+        }
+    }
+    error("unsupported foating point type '{}'", type);
+}
+
+template<class Id> std::string lower(ll::Lowerer&, const Def*, const std::string& name);
+
+template<> std::string lower<math::arith>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto arith  = force<math::arith>(def);
+    auto [a, b] = arith->args<2>([&](auto def) { return be.emit(def); });
+    return be.assign(name, "{} {} {}, {}", *be.binop(arith->callee()), be.convert(arith->type()), a, b);
+}
+
+template<> std::string lower<math::tri>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto tri = force<math::tri>(def);
+    auto a = be.emit(tri->arg());
+    auto t = be.convert(tri->type());
+
+    std::string f;
+
+    if (tri.id() == math::tri::sin) {
+        f = "llvm.sin"s + llvm_suffix(tri->type());
+    } else if (tri.id() == math::tri::cos) {
+        f = "llvm.cos"s + llvm_suffix(tri->type());
+    } else {
+        if (tri.sub() & sub_t(math::tri::a)) f += "a";
+
+        switch (math::tri((tri.id() & 0x3) | Annex::Base<math::tri>)) {
+            case math::tri::sin: f += "sin"; break;
+            case math::tri::cos: f += "cos"; break;
+            case math::tri::tan: f += "tan"; break;
+            case math::tri::ahFF: error("this axiom is supposed to be unused");
+            default: fe::unreachable();
+        }
+
+        if (tri.sub() & sub_t(math::tri::h)) f += "h";
+        f += core::math_suffix(tri->type());
+    }
+
+    be.declare("{} @{}({})", t, f, t);
+    return be.assign(name, "tail call {} @{}({} {})", t, f, t, a);
+}
+
+template<> std::string lower<math::extrema>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto extrema = force<math::extrema>(def);
+    auto [a, b]   = extrema->args<2>([&](auto def) { return be.emit(def); });
+    auto t        = be.convert(extrema->type());
+    std::string f = "llvm.";
+    switch (extrema.id()) {
+        case math::extrema::fmin: f += "minnum"; break;
+        case math::extrema::fmax: f += "maxnum"; break;
+        case math::extrema::ieee754min: f += "minimum"; break;
+        case math::extrema::ieee754max: f += "maximum"; break;
+    }
+    f += llvm_suffix(extrema->type());
+
+    be.declare("{} @{}({}, {})", t, f, t, t);
+    return be.assign(name, "tail call {} @{}({} {}, {} {})", t, f, t, a, t, b);
+}
+
+template<> std::string lower<math::pow>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto pow = force<math::pow>(def);
+    auto [a, b]   = pow->args<2>([&](auto def) { return be.emit(def); });
+    auto t        = be.convert(pow->type());
+    std::string f = "llvm.pow";
+    f += llvm_suffix(pow->type());
+    be.declare("{} @{}({}, {})", t, f, t, t);
+    return be.assign(name, "tail call {} @{}({} {}, {} {})", t, f, t, a, t, b);
+}
+
+template<> std::string lower<math::rt>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto rt = force<math::rt>(def);
+    auto a = be.emit(rt->arg());
+    auto t = be.convert(rt->type());
+    std::string f;
+    if (rt.id() == math::rt::sq)
+        f = "llvm.sqrt"s + llvm_suffix(rt->type());
+    else
+        f = "cbrt"s += core::math_suffix(rt->type());
+    be.declare("{} @{}({})", t, f, t);
+    return be.assign(name, "tail call {} @{}({} {})", t, f, t, a);
+}
+
+template<> std::string lower<math::exp>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto exp = force<math::exp>(def);
+    auto a        = be.emit(exp->arg());
+    auto t        = be.convert(exp->type());
+    std::string f = "llvm.";
+    f += (exp.sub() & sub_t(math::exp::log)) ? "log" : "exp";
+    f += (exp.sub() & sub_t(math::exp::bin)) ? "2" : (exp.sub() & sub_t(math::exp::dec)) ? "10" : "";
+    f += llvm_suffix(exp->type());
+    // TODO doesn't work for exp10"
+    be.declare("{} @{}({})", t, f, t);
+    return be.assign(name, "tail call {} @{}({} {})", t, f, t, a);
+}
+
+template<> std::string lower<math::er>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto er = force<math::er>(def);
+    auto a = be.emit(er->arg());
+    auto t = be.convert(er->type());
+    auto f = er.id() == math::er::f ? "erf"s : "erfc"s;
+    f += core::math_suffix(er->type());
+    be.declare("{} @{}({})", t, f, t);
+    return be.assign(name, "tail call {} @{}({} {})", t, f, t, a);
+}
+
+template<> std::string lower<math::gamma>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto gamma = force<math::gamma>(def);
+    auto a        = be.emit(gamma->arg());
+    auto t        = be.convert(gamma->type());
+    std::string f = gamma.id() == math::gamma::t ? "tgamma" : "lgamma";
+    f += core::math_suffix(gamma->type());
+    be.declare("{} @{}({})", t, f, t);
+    return be.assign(name, "tail call {} @{}({} {})", t, f, t, a);
+}
+
+template<> std::string lower<math::cmp>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto cmp = force<math::cmp>(def);
+    std::string op;
+    auto [a, b] = cmp->args<2>([&](auto def) { return be.emit(def); });
+    auto t      = be.convert(cmp->arg(0)->type());
+    op          = "fcmp ";
+
+    switch (cmp.id()) {
+        // clang-format off
+        case math::cmp::  e: op += "oeq"; break;
+        case math::cmp::  l: op += "olt"; break;
+        case math::cmp:: le: op += "ole"; break;
+        case math::cmp::  g: op += "ogt"; break;
+        case math::cmp:: ge: op += "oge"; break;
+        case math::cmp:: ne: op += "one"; break;
+        case math::cmp::  o: op += "ord"; break;
+        case math::cmp::  u: op += "uno"; break;
+        case math::cmp:: ue: op += "ueq"; break;
+        case math::cmp:: ul: op += "ult"; break;
+        case math::cmp::ule: op += "ule"; break;
+        case math::cmp:: ug: op += "ugt"; break;
+        case math::cmp::uge: op += "uge"; break;
+        case math::cmp::une: op += "une"; break;
+        // clang-format on
+        default: fe::unreachable();
+    }
+
+    return be.assign(name, "{} {} {}, {}", op, t, a, b);
+}
+
+template<> std::string lower<math::conv>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto conv = force<math::conv>(def);
+    std::string op;
+    auto v_src = be.emit(conv->arg());
+    auto t_src = be.convert(conv->arg()->type());
+    auto t_dst = be.convert(conv->type());
+
+    auto s_src = math::isa_f(conv->arg()->type());
+    auto s_dst = math::isa_f(conv->type());
+
+    switch (conv.id()) {
+        case math::conv::f2f: op = s_src < s_dst ? "fpext" : "fptrunc"; break;
+        case math::conv::s2f: op = "sitofp"; break;
+        case math::conv::u2f: op = "uitofp"; break;
+        case math::conv::f2s: op = "fptosi"; break;
+        case math::conv::f2u: op = "fptoui"; break;
+    }
+
+    return be.assign(name, "{} {} {} to {}", op, t_src, v_src, t_dst);
+}
+
+template<> std::string lower<math::abs>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto abs = force<math::abs>(def);
+    auto a        = be.emit(abs->arg());
+    auto t        = be.convert(abs->type());
+    std::string f = "llvm.fabs";
+    f += llvm_suffix(abs->type());
+    be.declare("{} @{}({})", t, f, t);
+    return be.assign(name, "tail call {} @{}({} {})", t, f, t, a);
+}
+
+template<> std::string lower<math::round>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto round = force<math::round>(def);
+    auto a        = be.emit(round->arg());
+    auto t        = be.convert(round->type());
+    std::string f = "llvm.";
+    switch (round.id()) {
+        case math::round::f: f += "floor"; break;
+        case math::round::c: f += "ceil"; break;
+        case math::round::r: f += "round"; break;
+        case math::round::t: f += "trunc"; break;
+    }
+    f += llvm_suffix(round->type());
+    be.declare("{} @{}({})", t, f, t);
+    return be.assign(name, "tail call {} @{}({} {})", t, f, t, a);
+}
+
+template<class... Ids> void add(Lowerings& lowerings) {
+    (assert_emplace(lowerings, Annex::Base<Ids>, &lower<Ids>), ...);
+}
+
+} // namespace
+
+void register_lowerings(Lowerings& lowerings) {
+    add<math::arith, math::tri, math::extrema, math::pow, math::rt, math::exp, math::er, math::gamma, math::cmp,
+        math::conv, math::abs, math::round>(lowerings);
+}
+
+} // namespace thorin::math
@@ -3,8 +3,11 @@
 #include <thorin/config.h>
 #include <thorin/pass/pass.h>
 
+#include "dialects/math/be/ll.h"
+
 using namespace thorin;
 
 extern "C" THORIN_EXPORT Plugin thorin_get_plugin() {
-    return {"math", [](Normalizers& normalizers) { math::register_normalizers(normalizers); }, nullptr, nullptr};
+    return {"math", [](Normalizers& normalizers) { math::register_normalizers(normalizers); }, nullptr, nullptr,
+            [](Lowerings& lowerings) { math::register_lowerings(lowerings); }};
 }
@@ -22,5 +22,5 @@ extern "C" THORIN_EXPORT Plugin thorin_get_plugin() {
                 register_pass<matrix::internal_map_reduce_cleanup, thorin::compile::InternalCleanup>(passes,
                                                                                                      INTERNAL_PREFIX);
             },
-            nullptr};
+            nullptr, nullptr};
 }
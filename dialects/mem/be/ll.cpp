@@ -0,0 +1,94 @@
+#include "dialects/mem/be/ll.h"
+
+#include <thorin/be/ll/lowerer.h>
+
+#include "dialects/mem/mem.h"
+
+namespace thorin::mem {
+
+namespace {
+
+template<class Id> std::string lower(ll::Lowerer&, const Def*, const std::string& name);
+
+template<> std::string lower<mem::lea>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto lea = force<mem::lea>(def);
+    auto [ptr, i]  = lea->args<2>();
+    auto pointee   = force<mem::Ptr>(ptr->type())->arg(0);
+    auto v_ptr     = be.emit(ptr);
+    auto t_pointee = be.convert(pointee);
+    auto t_ptr     = be.convert(ptr->type());
+    if (pointee->isa<Sigma>())
+        return be.assign(name, "getelementptr inbounds {}, {} {}, i64 0, i32 {}", t_pointee, t_ptr, v_ptr,
+                         Lit::as(i));
+
+    assert(pointee->isa<Arr>());
+    auto [v_i, t_i] = be.gep_index(i, name);
+
+    return be.assign(name, "getelementptr inbounds {}, {} {}, i64 0, {} {}", t_pointee, t_ptr, v_ptr, t_i, v_i);
+}
+
+template<> std::string lower<mem::malloc>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto malloc = force<mem::malloc>(def);
+    be.declare("i8* @malloc(i64)");
+
+    be.emit_unsafe(malloc->arg(0));
+    auto size  = be.emit(malloc->arg(1));
+    auto ptr_t = be.convert(force<mem::Ptr>(def->proj(1)->type()));
+    be.assign(name + ".i8", "call i8* @malloc(i64 {})", size);
+    return be.assign(name, "bitcast i8* {} to {}", name + ".i8", ptr_t);
+}
+
+template<> std::string lower<mem::free>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto free = force<mem::free>(def);
+    be.declare("void @free(i8*)");
+    be.emit_unsafe(free->arg(0));
+    auto ptr   = be.emit(free->arg(1));
+    auto ptr_t = be.convert(force<mem::Ptr>(free->arg(1)->type()));
+
+    be.assign(name + ".i8", "bitcast {} {} to i8*", ptr_t, ptr);
+    be.tail("call void @free(i8* {})", name + ".i8");
+    return {};
+}
+
+template<> std::string lower<mem::mslot>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto mslot = force<mem::mslot>(def);
+    be.emit_unsafe(mslot->arg(0));
+    // TODO array with size
+    // auto v_size = emit(mslot->arg(1));
+    auto [pointee, addr_space] = mslot->decurry()->args<2>();
+    be.body("{} = alloca {}", name, be.convert(pointee));
+    return name;
+}
+
+template<> std::string lower<mem::load>(ll::Lowerer& be, const Def* def, const std::string& name) {
+    auto load = force<mem::load>(def);
+    be.emit_unsafe(load->arg(0));
+    auto v_ptr     = be.emit(load->arg(1));
+    auto t_ptr     = be.convert(load->arg(1)->type());
+    auto pointee   = force<mem::Ptr>(load->arg(1)->type())->arg(0);
+    auto t_pointee = be.convert(pointee);
+    return be.assign(name, "load {}, {} {}{}", t_pointee, t_ptr, v_ptr, be.tbaa(load->arg(1)));
+}
+
+template<> std::string lower<mem::store>(ll::Lowerer& be, const Def* def, const std::string&) {
+    auto store = force<mem::store>(def);
+    be.emit_unsafe(store->arg(0));
+    auto v_ptr = be.emit(store->arg(1));
+    auto v_val = be.emit(store->arg(2));
+    auto t_ptr = be.convert(store->arg(1)->type());
+    auto t_val = be.convert(store->arg(2)->type());
+    be.body("store {} {}, {} {}{}", t_val, v_val, t_ptr, v_ptr, be.tbaa(store->arg(1)));
+    return {};
+}
+
+template<class... Ids> void add(Lowerings& lowerings) {
+    (assert_emplace(lowerings, Annex::Base<Ids>, &lower<Ids>), ...);
+}
+
+} // namespace
+
+void register_lowerings(Lowerings& lowerings) {
+    add<mem::lea, mem::malloc, mem::free, mem::mslot, mem::load, mem::store>(lowerings);
+}
+
+} // namespace thorin::mem
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "thorin/plugin.h"
+
+namespace thorin::mem {
+
+/// Registers the rules that lower the Axiom%s of this Plugin to LLVM IR; see Plugin::register_lowerings.
+void register_lowerings(Lowerings&);
+
+} // namespace thorin::mem
@@ -7,6 +7,7 @@
 #include <thorin/pass/pipelinebuilder.h>
 
 #include "dialects/mem/autogen.h"
+#include "dialects/mem/be/ll.h"
 #include "dialects/mem/pass/fp/copy_prop.h"
 #include "dialects/mem/pass/fp/ssa_constr.h"
 #include "dialects/mem/pass/rw/alloc2malloc.h"
@@ -43,5 +44,5 @@ extern "C" THORIN_EXPORT Plugin thorin_get_plugin() {
                       };
                 register_phase<mem::add_mem_phase, mem::AddMem>(passes);
             },
-            nullptr};
+            nullptr, [](Lowerings& lowerings) { mem::register_lowerings(lowerings); }};
 }
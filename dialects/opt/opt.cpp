@@ -33,5 +33,5 @@ extern "C" THORIN_EXPORT Plugin thorin_get_plugin() {
                     compile::handle_optimization_part(is_loaded ? then_phase : else_phase, world, passes, builder);
                 };
             },
-            nullptr};
+            nullptr, nullptr};
 }
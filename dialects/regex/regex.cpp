@@ -12,5 +12,5 @@ using namespace thorin;
 /// Registers Pass%es in the different optimization Phase%s as well as normalizers for the Axiom%s.
 extern "C" THORIN_EXPORT Plugin thorin_get_plugin() {
     return {"regex", [](Normalizers& normalizers) { regex::register_normalizers(normalizers); },
-            [](Passes& passes) { register_pass<regex::lower_regex, regex::LowerRegex>(passes); }, nullptr};
+            [](Passes& passes) { register_pass<regex::lower_regex, regex::LowerRegex>(passes); }, nullptr, nullptr};
 }
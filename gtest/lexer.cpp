@@ -1,5 +1,7 @@
 #include "thorin/fe/lexer.h"
 
+#include <chrono>
+#include <fstream>
 #include <sstream>
 #include <string>
 
@@ -7,6 +9,10 @@
 
 #include "thorin/driver.h"
 
+#include "thorin/fe/md.h"
+
+#include "thorin/util/mmap.h"
+
 using namespace std::literals;
 using namespace thorin;
 
@@ -67,6 +73,81 @@ TEST(Lexer, Eof) {
     for (int i = 0; i < 10; i++) EXPECT_TRUE(lexer.lex().isa(Tok::Tag::EoF));
 }
 
+TEST(Lexer, MMap) {
+    Driver driver;
+    std::ostringstream src;
+    for (int i = 0; i != 10000; ++i)
+        src << ".let x_" << i << ": %core.I32 = %core.wrap.add 0 (x.y, 0x2a); // comment λ\n"
+            << "/* multi\n line */ .con f_" << i << " [m: %mem.M] = (ret, «2; ⊥»)#.ff m;\n";
+
+    auto path = fs::temp_directory_path() / "thorin-gtest-mmap.thorin";
+    std::ofstream(path) << src.str();
+    MMap file(path);
+    ASSERT_TRUE(file);
+    EXPECT_EQ(file.view(), src.str());
+
+    std::istream is1(&file);
+    std::istringstream is2(src.str());
+    Lexer l1(driver.world(), is1, &path);
+    Lexer l2(driver.world(), is2, &path);
+    for (size_t n = 0;; ++n) {
+        auto t1 = l1.lex(), t2 = l2.lex();
+        ASSERT_EQ(t1.tag(), t2.tag()) << "token " << n;
+        if (t1.isa(Tok::Tag::M_id)) {
+            EXPECT_EQ(t1.sym(), t2.sym());
+        }
+        if (t1.isa(Tok::Tag::EoF)) break;
+    }
+    fs::remove(path);
+}
+
+TEST(Lexer, Md) {
+    Driver driver;
+    auto md = [&](std::string_view src) {
+        std::ostringstream os;
+        emit_md(driver.world(), src, nullptr, os);
+        return os.str();
+    };
+
+    EXPECT_EQ(md("/// # Mod\n///\n/// Text.\n.let x = 23;\n/// Doc λ.\n.let y = x;\n"),
+              "# Mod\n\nText.\n```\n.let x = 23;\n```\nDoc λ.\n```\n.let y = x;\n\n```\n");
+    EXPECT_EQ(md(".let λ = \"///\"; /// é\n"), "```\n.let λ = \"///\"; ```\né\n");
+    EXPECT_EQ(md("// /// no doc\n"), "```\n// /// no doc\n\n```\n");
+    EXPECT_EQ(md(""), "```\n\n```\n");
+}
+
+// The timings are no pass/fail criterion; they end up as properties in the report of `--gtest_output=xml`.
+TEST(Lexer, Bench) {
+    Driver driver;
+    std::ostringstream oss;
+    for (int i = 0; i != 10000; ++i)
+        oss << "/// Adds `x_" << i << "` to itself.\n"
+            << ".let x_" << i << ": %core.I32 = %core.wrap.add 0 (x.y, 0x2a); // comment λ\n";
+    auto src = oss.str();
+
+    using Clock = std::chrono::steady_clock;
+
+    auto time = [](auto f) {
+        auto begin = Clock::now();
+        f();
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - begin).count();
+    };
+
+    size_t num = 0;
+    auto lex   = time([&] {
+        std::istringstream is(src);
+        Lexer lexer(driver.world(), is);
+        while (!lexer.lex().isa(Tok::Tag::EoF)) ++num;
+    });
+    std::ostringstream md;
+    auto emit = time([&] { emit_md(driver.world(), src, nullptr, md); });
+
+    EXPECT_EQ(num, 10000 * 13);
+    EXPECT_EQ(md.str().size(), src.size() - 10000 * 4 /*"/// "*/ + (2 * 10000 - 1) * 4 /*fences*/ + 5);
+    RecordProperty("lex_us", std::to_string(lex));
+    RecordProperty("md_us", std::to_string(emit));
+}
+
 class Real : public testing::TestWithParam<int> {};
 
 TEST_P(Real, sign) {
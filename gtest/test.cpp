@@ -7,9 +7,13 @@
 #include "thorin/driver.h"
 #include "thorin/rewrite.h"
 
+#include "thorin/analyses/callgraph.h"
+#include "thorin/analyses/liveness.h"
 #include "thorin/fe/parser.h"
+#include "thorin/util/sys.h"
 
 #include "dialects/core/core.h"
+#include "dialects/mem/mem.h"
 #include "helpers.h"
 
 using namespace thorin;
@@ -84,6 +88,31 @@ TEST(Annex, split) {
     EXPECT_EQ(tag, w.sym("baz"));
 }
 
+TEST(Annex, normalizers) {
+    Driver driver;
+    World& w = driver.world();
+
+    auto foo       = *Annex::mangle(w.sym("foo"));
+    auto bar       = *Annex::mangle(w.sym("bar"));
+    NormalizeFn f1 = [](Ref, Ref, Ref arg) -> Ref { return arg; };
+    NormalizeFn f2 = [](Ref, Ref callee, Ref) -> Ref { return callee; };
+
+    Normalizers normalizers;
+    normalizers.add(foo, {{f1, f2}, {}, {f2}});
+    EXPECT_EQ(normalizers.find(foo | 0x0000_u64), f1);
+    EXPECT_EQ(normalizers.find(foo | 0x0001_u64), f2);
+    EXPECT_FALSE(normalizers.find(foo | 0x0002_u64));
+    EXPECT_FALSE(normalizers.find(foo | 0x0100_u64));
+    EXPECT_EQ(normalizers.find(foo | 0x0200_u64), f2);
+    EXPECT_FALSE(normalizers.find(foo | 0x0300_u64));
+    EXPECT_FALSE(normalizers.find(bar | 0x0000_u64));
+
+    normalizers[foo | 0x0305_u64] = f1;
+    EXPECT_EQ(normalizers.find(foo | 0x0305_u64), f1);
+    EXPECT_FALSE(normalizers.find(foo | 0x0304_u64));
+    EXPECT_EQ(normalizers.find(foo | 0x0001_u64), f2);
+}
+
 TEST(trait, idx) {
     Driver driver;
     World& w    = driver.world();
@@ -269,6 +298,193 @@ TEST(Check, alpha) {
     check(l_1, l_1, true, true);
 }
 
+TEST(Check, memo) {
+    Driver driver;
+    World& w = driver.world();
+    auto nat = w.type_nat();
+    auto pi  = w.pi(nat, w.sigma({nat, nat, nat}));
+
+    // λx.(x, x, 0) and λy.(y, y, 0) compare x and y twice
+    auto lx = w.mut_lam(pi);
+    lx->set(false, w.tuple({lx->var(), lx->var(), w.lit_nat_0()}));
+    auto ly = w.mut_lam(pi);
+    ly->set(false, w.tuple({ly->var(), ly->var(), w.lit_nat_0()}));
+
+    auto hits = w.check_stats().memo_hits;
+    EXPECT_TRUE(Check::alpha<false>(lx, ly));
+    EXPECT_GT(w.check_stats().memo_hits, hits);
+
+    auto rejects = w.check_stats().hash_rejects;
+    EXPECT_FALSE(Check::alpha<false>(w.lit_nat_0(), w.lit_nat_1()));
+    EXPECT_GT(w.check_stats().hash_rejects, rejects);
+}
+
+TEST(CallGraph, scc) {
+    Driver driver;
+    World& w = driver.world();
+    auto nat = w.type_nat();
+    auto ret = w.cn(nat);
+    auto cn  = w.cn({nat, ret});
+
+    auto main = w.mut_lam(cn)->set("main");
+    auto f    = w.mut_lam(cn)->set("f");
+    auto g    = w.mut_lam(cn)->set("g");
+    auto h    = w.mut_lam(ret)->set("h");
+    main->app(false, f, {main->var(0), main->var(1)});
+    f->app(false, g, {f->var(0), f->var(1)});
+    g->app(false, f, {g->var(0), h});
+    h->app(false, g->var(1), h->var());
+    main->make_external();
+
+    CallGraph cg(w);
+    EXPECT_EQ(cg.size(), 4u);
+    EXPECT_EQ(cg.sccs().size(), 3u);
+    EXPECT_EQ(cg.bottom_up().front(), std::vector<Lam*>{h});
+    EXPECT_EQ(cg.bottom_up().back(), std::vector<Lam*>{main});
+    EXPECT_EQ(cg.top_down().front(), std::vector<Lam*>{main});
+    EXPECT_TRUE(cg.same_scc(f, g));
+    EXPECT_TRUE(cg.is_recursive(f));
+    EXPECT_FALSE(cg.is_recursive(main));
+    EXPECT_FALSE(cg.is_recursive(h));
+    EXPECT_EQ(cg[g]->edge(f), (unsigned)CGNode::Edge::Direct);
+    EXPECT_EQ(cg[g]->edge(h), (unsigned)CGNode::Edge::Higher);
+    EXPECT_TRUE(cg[h]->has_indirect_call());
+    EXPECT_FALSE(cg[f]->has_indirect_call());
+}
+
+TEST(DataFlow, liveness) {
+    Driver driver;
+    World& w  = driver.world();
+    auto nat  = w.type_nat();
+    auto ret  = w.cn(nat);
+    auto f    = w.mut_lam(w.cn({w.type_bool(), nat, ret}))->set("f");
+    auto head = w.mut_lam(w.cn(nat))->set("head");
+    auto body = w.mut_lam(w.cn())->set("body");
+    auto exit = w.mut_lam(w.cn())->set("exit");
+
+    f->app(false, head, f->var(1));
+    head->branch(false, f->var(0), body, exit);
+    body->app(false, head, head->var());
+    exit->app(false, f->var(2), f->var(1));
+    f->make_external();
+
+    Scope scope(f);
+    Liveness live(scope);
+    const auto& cfg = live.cfg();
+    auto fv         = f->var()->as<Var>();
+    auto hv         = head->var()->as<Var>();
+
+    EXPECT_EQ(live.num_vars(), 2u);
+    EXPECT_FALSE(live.is_live_in(cfg[f], fv));
+    EXPECT_TRUE(live.is_live_in(cfg[head], fv));
+    EXPECT_TRUE(live.is_live_in(cfg[body], fv));
+    EXPECT_TRUE(live.is_live_in(cfg[body], hv));
+    EXPECT_TRUE(live.is_live_in(cfg[exit], fv));
+    EXPECT_FALSE(live.is_live_in(cfg[exit], hv));
+    EXPECT_FALSE(live.is_live_out(cfg[exit], fv));
+
+    // compare against naive round-robin iteration until nothing changes anymore
+    auto lattice = live.dataflow().lattice();
+    B_CFG::Map<BitSet> in(cfg), out(cfg);
+    size_t num_transfers = 0;
+    for (bool todo = true; todo;) {
+        todo = false;
+        for (auto n : cfg.reverse_post_order()) {
+            BitSet o;
+            for (auto pred : cfg.preds(n)) o |= in[pred];
+            auto i = lattice.transfer(n, o);
+            ++num_transfers;
+            todo |= i != in[n];
+            in[n]  = std::move(i);
+            out[n] = std::move(o);
+        }
+    }
+
+    for (auto n : cfg.reverse_post_order()) {
+        EXPECT_EQ(live.live_in(n), in[n]);
+        EXPECT_EQ(live.live_out(n), out[n]);
+    }
+    EXPECT_LE(live.dataflow().num_transfers(), num_transfers);
+}
+
+TEST(Driver, many_imports) {
+    Driver driver;
+    World& w = driver.world();
+
+    // each file imports all previous ones
+    constexpr int N = 200;
+    auto dir        = fs::temp_directory_path() / "thorin-gtest-imports";
+    fs::create_directories(dir);
+    for (int i = 0; i != N; ++i) {
+        std::ofstream ofs(dir / ("f_" + std::to_string(i) + ".thorin"));
+        for (int j = 0; j != i; ++j) ofs << ".import f_" << j << ";\n";
+        ofs << ".let x_" << i << " = " << i << ";\n";
+    }
+
+    driver.add_search_path(dir);
+    auto parser = Parser(w);
+    parser.import("f_" + std::to_string(N - 1));
+    EXPECT_EQ(driver.imports().size(), size_t(N));
+
+    parser.import(dir / "f_0.thorin"); // same file via a different path
+    EXPECT_EQ(driver.imports().size(), size_t(N));
+    fs::remove_all(dir);
+}
+
+TEST(Driver, static_plugin) {
+    register_static_plugin("static_test", []() -> Plugin {
+        return {"static_test", nullptr, nullptr,
+                [](Backends& backends) { backends["static_test"] = [](World&, std::ostream& os) { os << "ok"; }; },
+                nullptr};
+    });
+
+    Driver driver;
+    driver.load("static_test"); // no such file anywhere
+    EXPECT_TRUE(driver.is_loaded(driver.sym("static_test")));
+    std::ostringstream oss;
+    if (auto backend = driver.backend("static_test")) backend(driver.world(), oss);
+    EXPECT_EQ(oss.str(), "ok");
+}
+
+// Globals have no syntax; hence, this isn't a lit test like lit/core/ll_partitions.thorin.
+TEST(LL, partitions_global) {
+    Driver driver;
+    World& w    = driver.world();
+    auto parser = Parser(w);
+    for (auto plugin : {"compile", "mem", "core", "math"}) parser.plugin(plugin);
+    driver.flags().ll_partitions = 3;
+
+    auto mem_t  = w.annex<mem::M>();
+    auto i32_t  = w.type_int(32);
+    auto argv_t = w.call<mem::Ptr0>(w.call<mem::Ptr0>(w.type_int(8)));
+
+    auto global = w.global(w.call<mem::Ptr0>(i32_t))->set("counter");
+    global->set(w.lit_int(32, 0));
+
+    // main, put, and get end up in different partitions; put writes the Global and get reads it
+    auto put = w.mut_lam(w.cn({mem_t, i32_t, w.cn(mem_t)}))->set("put");
+    put->app(false, put->var(2_s), w.call<mem::store>(Defs{put->var(0_s), global, put->var(1_s)}));
+
+    auto get = w.mut_lam(w.cn({mem_t, w.cn({mem_t, i32_t})}))->set("get");
+    get->app(false, get->var(1_s), w.call<mem::load>(Defs{get->var(0_s), global}));
+
+    auto main = w.mut_lam(w.cn({mem_t, i32_t, argv_t, w.cn({mem_t, i32_t})}))->set("main");
+    main->make_external();
+    auto got = w.mut_lam(w.cn(mem_t))->set("got");
+    got->app(false, get, {got->var(), main->var(3_s)});
+    main->app(false, put, {main->var(0_s), main->var(1_s), got});
+
+    // the linker rejects a Global that no partition or more than one partition defines
+    auto exe = fs::temp_directory_path() / fmt("thorin-gtest-partitions.{}", sys::pid());
+    {
+        std::ofstream ofs(exe, std::ios::binary);
+        driver.backend("exe")(w, ofs);
+    }
+    fs::permissions(exe, fs::perms::owner_exec, fs::perm_options::add);
+    EXPECT_EQ(sys::system(fmt("\"{}\" a b", exe.string())), 3); // argc
+    fs::remove(exe);
+}
+
 TEST(ADT, Span) {
     {
         int a[3]        = {0, 1, 2};
@@ -1,10 +1,12 @@
 import lit.formats
+import lit.util
 import os
 
 config.name = 'thorin regression'
 config.test_format = lit.formats.ShTest(True)
 
 config.suffixes = ['.thorin']
+config.excludes = ['Inputs'] # shared inputs of several tests - not tests on their own
 
 config.test_source_root = os.path.dirname(__file__)
 config.test_exec_root = os.path.join(config.my_obj_root, 'test')
@@ -15,4 +17,6 @@ config.substitutions.append(('%thorin', config.thorin))
 config.environment = os.environ
 
 config.available_features.add("always")
+if lit.util.pythonize_bool(config.thorin_enable_llvm):
+    config.available_features.add("llvm")
 
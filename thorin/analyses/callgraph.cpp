@@ -0,0 +1,126 @@
+#include "thorin/analyses/callgraph.h"
+
+#include "thorin/world.h"
+
+namespace thorin {
+
+void CGNode::link(CGNode* callee, Edge e) {
+    auto [i, inserted] = edges_.emplace(callee->lam(), 0);
+    i->second |= (unsigned)e;
+    if (inserted) {
+        callees_.emplace_back(callee);
+        callee->callers_.emplace_back(this);
+    }
+}
+
+bool CallGraph::is_recursive(Lam* lam) const {
+    auto n = (*this)[lam];
+    return sccs_[n->scc()].size() > 1 || n->edge(lam) != 0;
+}
+
+CGNode* CallGraph::node(Lam* lam) {
+    auto [i, inserted] = lam2node_.emplace(lam, std::unique_ptr<CGNode>());
+    if (inserted) {
+        i->second = std::make_unique<CGNode>(lam);
+        nodes_.emplace_back(i->second.get());
+    }
+    return i->second.get();
+}
+
+void CallGraph::run() {
+    for (const auto& [_, mut] : world().externals())
+        if (auto lam = mut->isa<Lam>()) node(lam);
+
+    // nodes_ grows while we iterate
+    for (size_t i = 0; i != nodes_.size(); ++i) run(nodes_[i]);
+
+    size_t dfs = 0;
+    std::vector<CGNode*> stack;
+    for (auto n : nodes_)
+        if (n->dfs_ == size_t(-1)) tarjan(n, dfs, stack);
+}
+
+/// Collects all Lam%s referenced from @p caller's body without entering other Lam%s.
+/// Muts that are not Lam%s - e.g. a recursive Sigma - are part of the caller and, hence, traversed.
+void CallGraph::run(CGNode* caller) {
+    auto lam = caller->lam();
+    if (!lam->is_set()) return;
+
+    unique_queue<DefSet> queue;
+    auto enqueue = [&](const Def* def, CGNode::Edge e) {
+        if (def->dep_const() || def->isa<Var>()) return; // Var::mut would lead back to its binder
+        if (auto callee = def->isa_mut<Lam>())
+            caller->link(node(callee), e);
+        else
+            queue.push(def);
+    };
+
+    for (auto op : lam->extended_ops()) enqueue(op, CGNode::Edge::Higher);
+
+    while (!queue.empty()) {
+        auto def = queue.pop();
+
+        if (auto app = def->isa<App>(); app && !app->axiom()) {
+            auto callee = app->callee();
+            if (auto l = callee->isa_mut<Lam>()) {
+                caller->link(node(l), CGNode::Edge::Direct);
+            } else if (auto branch = callee->isa<Extract>(); branch && branch->tuple()->isa<Tuple>()) {
+                for (auto op : branch->tuple()->ops()) enqueue(op, CGNode::Edge::Direct);
+                enqueue(branch->index(), CGNode::Edge::Higher);
+            } else {
+                caller->indirect_ = true;
+                enqueue(callee, CGNode::Edge::Higher);
+            }
+            enqueue(app->arg(), CGNode::Edge::Higher);
+            enqueue(app->type(), CGNode::Edge::Higher);
+            continue;
+        }
+
+        for (auto op : def->extended_ops()) enqueue(op, CGNode::Edge::Higher);
+    }
+}
+
+// Iterative - the recursion depth would grow with the size of the program otherwise.
+void CallGraph::tarjan(CGNode* root, size_t& dfs, std::vector<CGNode*>& stack) {
+    std::vector<std::pair<CGNode*, size_t>> frames; // CGNode and index of its next callee
+    auto enter = [&](CGNode* n) {
+        n->dfs_ = n->low_ = dfs++;
+        n->on_stack_      = true;
+        stack.emplace_back(n);
+        frames.emplace_back(n, 0);
+    };
+
+    enter(root);
+    while (!frames.empty()) {
+        auto [n, i] = frames.back();
+        if (i != n->callees().size()) {
+            auto callee = n->callees()[i];
+            ++frames.back().second;
+            if (callee->dfs_ == size_t(-1))
+                enter(callee);
+            else if (callee->on_stack_)
+                n->low_ = std::min(n->low_, callee->dfs_);
+            continue;
+        }
+
+        frames.pop_back();
+        if (!frames.empty()) {
+            auto parent  = frames.back().first;
+            parent->low_ = std::min(parent->low_, n->low_);
+        }
+
+        if (n->low_ == n->dfs_) {
+            auto& scc = sccs_.emplace_back();
+            CGNode* m;
+            do {
+                m = stack.back();
+                stack.pop_back();
+                m->on_stack_ = false;
+                m->scc_      = sccs_.size() - 1;
+                scc.emplace_back(m->lam());
+            } while (m != n);
+        }
+    }
+}
+
+} // namespace thorin
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <memory>
+#include <ranges>
+#include <vector>
+
+#include "thorin/lam.h"
+
+namespace thorin {
+
+/// A node of the CallGraph: one for each reachable Lam.
+class CGNode {
+public:
+    /// How a Lam is referenced from within the body of another one.
+    enum class Edge : unsigned {
+        None   = 0,
+        Direct = 1 << 0, ///< Appears in App::callee position - either directly or as a branch target `(f, t)#cond`.
+        Higher = 1 << 1, ///< Is passed around as a value (e.g. as return continuation) and may be invoked by someone.
+    };
+
+    CGNode(Lam* lam)
+        : lam_(lam) {}
+
+    /// @name Getters
+    ///@{
+    Lam* lam() const { return lam_; }
+    const auto& callees() const { return callees_; } ///< In discovery order.
+    const auto& callers() const { return callers_; } ///< In discovery order.
+    size_t scc() const { return scc_; }              ///< Index into CallGraph::sccs().
+    /// Does CGNode::lam's body contain an App whose App::callee is neither a Lam nor a branch (e.g. a Var)?
+    bool has_indirect_call() const { return indirect_; }
+    /// Yields a bit mask of Edge%s from `this` to @p callee; `0` if there is none.
+    unsigned edge(Lam* callee) const {
+        auto i = edges_.find(callee);
+        return i != edges_.end() ? i->second : 0;
+    }
+    ///@}
+
+private:
+    void link(CGNode* callee, Edge e);
+
+    Lam* lam_;
+    std::vector<CGNode*> callees_;
+    std::vector<CGNode*> callers_;
+    LamMap<unsigned> edges_;
+    bool indirect_ = false;
+    size_t scc_    = -1;
+
+    // Tarjan
+    size_t dfs_    = -1;
+    size_t low_    = -1;
+    bool on_stack_ = false;
+
+    friend class CallGraph;
+};
+
+THORIN_ENUM_OPERATORS(CGNode::Edge)
+
+/// Whole-program call graph over all Lam%s reachable from World::externals.
+/// Its strongly connected components (SCCs) are computed via Tarjan's algorithm.
+/// Iterate CallGraph::bottom_up to see callees before their callers or CallGraph::top_down for the opposite.
+/// This allows interprocedural analyses to process the World in a single, ordered sweep.
+/// @note The graph is a snapshot: If you modify the World, you have to construct a new CallGraph.
+class CallGraph {
+public:
+    CallGraph(const CallGraph&)     = delete;
+    CallGraph& operator=(CallGraph) = delete;
+
+    explicit CallGraph(World& world)
+        : world_(world) {
+        run();
+    }
+
+    /// @name Getters
+    ///@{
+    World& world() const { return world_; }
+    size_t size() const { return nodes_.size(); }
+    const auto& nodes() const { return nodes_; } ///< All CGNode%s in discovery order.
+    const CGNode* operator[](Lam* lam) const {
+        auto i = lam2node_.find(lam);
+        return i == lam2node_.end() ? nullptr : i->second.get();
+    }
+    ///@}
+
+    /// @name SCCs
+    ///@{
+    /// Each SCC is a list of Lam%s; the list of SCCs is sorted such that all callees of a SCC come first.
+    const auto& sccs() const { return sccs_; }
+    const std::vector<Lam*>& scc(Lam* lam) const { return sccs_[(*this)[lam]->scc()]; }
+    const auto& bottom_up() const { return sccs_; }              ///< Callees before callers.
+    auto top_down() const { return std::views::reverse(sccs_); } ///< Callers before callees.
+    bool is_recursive(Lam* lam) const;                           ///< Is @p lam part of a cycle?
+    bool same_scc(Lam* a, Lam* b) const { return (*this)[a]->scc() == (*this)[b]->scc(); }
+    ///@}
+
+private:
+    void run();
+    void run(CGNode*);
+    void tarjan(CGNode*, size_t& dfs, std::vector<CGNode*>& stack);
+    CGNode* node(Lam*);
+
+    World& world_;
+    LamMap<std::unique_ptr<CGNode>> lam2node_;
+    std::vector<CGNode*> nodes_;
+    std::vector<std::vector<Lam*>> sccs_;
+};
+
+} // namespace thorin
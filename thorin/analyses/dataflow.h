@@ -0,0 +1,91 @@
+#pragma once
+
+#include "thorin/analyses/cfg.h"
+#include "thorin/util/bitset.h"
+
+namespace thorin {
+
+/// Generic worklist solver for monotone data-flow problems over a CFG.
+/// The direction of the analysis is determined by the CFG:
+/// Use an F_CFG for a *forward* problem and a B_CFG for a *backward* problem.
+/// DataFlow::in is the join of all DataFlow::out%s of the CFG::preds - w.r.t. this direction.
+/// Nodes are visited in CFG::reverse_post_order; all dirty nodes are processed in one sweep before starting over.
+/// This usually converges after `loop nesting depth + 2` sweeps.
+///
+/// The @p Lattice must provide:
+/// * `using Value = ...;`
+/// * `Value bottom() const;` - initial value of each node and neutral element of `join`.
+/// * `Value entry() const;` - boundary value that flows into CFG::entry.
+/// * `Value transfer(const CFNode* n, const Value& in) const;`
+/// * `bool join(Value& val, const Value& other) const;` - joins @p other into @p val and yields whether @p val changed.
+///   This one is optional if `Value` is a BitSet: Set union is used in this case.
+template<bool forward, class Lattice> class DataFlow {
+public:
+    using Value = typename Lattice::Value;
+
+    DataFlow(const DataFlow&)     = delete;
+    DataFlow& operator=(DataFlow) = delete;
+
+    explicit DataFlow(const CFG<forward>& cfg, Lattice lattice = {})
+        : cfg_(cfg)
+        , lattice_(std::move(lattice))
+        , in_(cfg, lattice_.bottom())
+        , out_(cfg, lattice_.bottom()) {
+        run();
+    }
+
+    /// @name Getters
+    ///@{
+    const CFG<forward>& cfg() const { return cfg_; }
+    const Lattice& lattice() const { return lattice_; }
+    const Value& in(const CFNode* n) const { return in_[n]; }
+    const Value& out(const CFNode* n) const { return out_[n]; }
+    size_t num_transfers() const { return num_transfers_; } ///< How often did we invoke `Lattice::transfer`?
+    size_t num_sweeps() const { return num_sweeps_; }       ///< How many passes over the CFG were necessary?
+    ///@}
+
+    /// Joins @p other into @p val and yields whether @p val changed.
+    bool join(Value& val, const Value& other) const {
+        if constexpr (requires { lattice_.join(val, other); }) {
+            return lattice_.join(val, other);
+        } else {
+            static_assert(std::is_same_v<Value, BitSet>, "Lattice::join is mandatory for non-BitSet values");
+            auto n = val.count();
+            val |= other;
+            return val.count() != n;
+        }
+    }
+
+private:
+    void run() {
+        BitSet dirty; // RPO indices
+        for (size_t i = 0, e = cfg().size(); i != e; ++i) dirty.set(i);
+
+        while (dirty.any()) {
+            ++num_sweeps_;
+            for (size_t i = 0, e = cfg().size(); i != e; ++i) {
+                if (!dirty.test(i)) continue;
+                dirty.clear(i);
+
+                auto n  = cfg().reverse_post_order(i);
+                auto in = n == cfg().entry() ? lattice_.entry() : lattice_.bottom();
+                for (auto pred : cfg().preds(n)) join(in, out_[pred]);
+
+                ++num_transfers_;
+                auto out = lattice_.transfer(n, in);
+                in_[n]   = std::move(in);
+                if (join(out_[n], out))
+                    for (auto succ : cfg().succs(n)) dirty.set(cfg().index(succ));
+            }
+        }
+    }
+
+    const CFG<forward>& cfg_;
+    Lattice lattice_;
+    typename CFG<forward>::template Map<Value> in_;
+    typename CFG<forward>::template Map<Value> out_;
+    size_t num_transfers_ = 0;
+    size_t num_sweeps_    = 0;
+};
+
+} // namespace thorin
@@ -1,68 +1,98 @@
 #include "thorin/analyses/deptree.h"
 
+#include <algorithm>
+
 #include "thorin/world.h"
 
 namespace thorin {
 
-namespace {
-void merge(VarSet& vars, VarSet&& other) { vars.insert(other.begin(), other.end()); }
-} // namespace
-
 void DepTree::run() {
     for (const auto& [_, mut] : world().externals()) run(mut);
     adjust_depth(root_.get(), 0);
+
+    world().DLOG("DepTree: {} muts; {} bytes for {} memoized defs", mut2node_.size(),
+                 def2binders_.capacity() * sizeof(decltype(def2binders_)::value_type), def2binders_.size());
+    def2binders_ = {};
 }
 
-VarSet DepTree::run(Def* mut) {
+BitSet DepTree::run(Def* mut) {
     auto [i, inserted] = mut2node_.emplace(mut, std::unique_ptr<DepNode>());
     if (!inserted) {
-        if (auto i = def2vars_.find(mut); i != def2vars_.end()) return i->second;
+        if (auto i = def2binders_.find(mut); i != def2binders_.end()) return binders(i->second);
         return {};
     }
 
     i->second = std::make_unique<DepNode>(mut, stack_.size() + 1);
     auto node = i->second.get();
-    stack_.push_back(node);
+    push(node);
 
     auto result = run(mut, mut);
     auto parent = root_.get();
-    for (auto var : result) {
-        auto n = mut2node_[var->mut()].get();
-        if (!n) {
-            world().ELOG("var {} used before mut {} discovered, old var still around?", var, var->mut());
-            world().ELOG("var {} : {} [{}]", var, var->type(), var->node_name());
-            world().ELOG("var mut {} : {}", var->mut(), var->mut()->type());
+    for (size_t i = stack_.size() - 1; i-- != 0;) {
+        if (result.test(i)) {
+            parent = stack_[i];
+            break;
         }
-        assert(n && "Old var still around?");
-        parent = n->depth() > parent->depth() ? n : parent;
     }
+
     if (mut->is_external() && parent != root_.get()) {
         world().WLOG("external {} would be hidden inside parent {}.", mut, parent->mut());
         node->set_parent(root_.get());
     } else
         node->set_parent(parent);
 
-    stack_.pop_back();
+    pop();
     return result;
 }
 
-VarSet DepTree::run(Def* curr_mut, const Def* def) {
+BitSet DepTree::run(Def* curr_mut, const Def* def) {
     if (def->dep_const()) return {};
-    if (auto i = def2vars_.find(def); i != def2vars_.end()) return i->second;
+    if (auto i = def2binders_.find(def); i != def2binders_.end()) return binders(i->second);
     if (auto mut = def->isa_mut(); mut && curr_mut != mut) return run(mut);
 
-    VarSet result;
+    BitSet result;
     if (auto var = def->isa<Var>()) {
-        result.emplace(var);
-    } else {
-        for (auto op : def->extended_ops()) merge(result, run(curr_mut, op));
-
-        if (auto v = curr_mut->var()) {
-            if (auto var = v->isa<Var>(); var && curr_mut == def) result.erase(var);
+        auto i = mut2node_.find(var->mut());
+        if (i == mut2node_.end()) {
+            world().ELOG("var {} used before mut {} discovered, old var still around?", var, var->mut());
+            world().ELOG("var {} : {} [{}]", var, var->type(), var->node_name());
+            world().ELOG("var mut {} : {}", var->mut(), var->mut()->type());
         }
+        assert(i != mut2node_.end() && "Old var still around?");
+
+        // A binder is on the stack_ iff its depth hasn't been adjusted yet, i.e. depth = stack_ index + 1.
+        auto n = i->second.get();
+        if (auto d = n->depth() - 1; d < stack_.size() && stack_[d] == n)
+            result.set(d);
+        else
+            world().WLOG("var {} escapes its mut {}", var, var->mut());
+    } else {
+        for (auto op : def->extended_ops()) result |= run(curr_mut, op);
+        if (curr_mut == def) result.clear(stack_.size() - 1); // curr_mut's own var is bound here
     }
 
-    return def2vars_[def] = result;
+    def2binders_[def] = {result, time_};
+    return result;
+}
+
+void DepTree::push(DepNode* node) {
+    stack_.push_back(node);
+    stamps_.push_back(++time_);
+}
+
+void DepTree::pop() {
+    stack_.pop_back();
+    stamps_.pop_back();
+}
+
+/// The stack_ indices in @p memo from `k` onwards may be stale: These binders have been popped since - and another
+/// mut may occupy the index by now. As stamps_ is sorted, `k` is the first stack_ index pushed after @p memo.
+/// The binders below `k` are still valid; the others are not in scope anymore - just as for an escaping Var.
+BitSet DepTree::binders(const Memo& memo) const {
+    auto k   = size_t(std::ranges::upper_bound(stamps_, memo.stamp) - stamps_.begin());
+    auto res = memo.binders;
+    for (size_t i = k; res.any_begin(i); ++i) res.clear(i);
+    return res;
 }
 
 void DepTree::adjust_depth(DepNode* node, size_t depth) {
@@ -4,6 +4,8 @@
 
 #include "thorin/def.h"
 
+#include "thorin/util/bitset.h"
+
 namespace thorin {
 
 class DepNode {
@@ -48,15 +50,30 @@ public:
 
 private:
     void run();
-    VarSet run(Def*);
-    VarSet run(Def*, const Def*);
+    BitSet run(Def*);
+    BitSet run(Def*, const Def*);
+    void push(DepNode*);
+    void pop();
     static void adjust_depth(DepNode* node, size_t depth);
 
+    struct Memo {
+        BitSet binders;
+        size_t stamp; ///< DepTree::time_ when memoized.
+    };
+
+    BitSet binders(const Memo&) const;
+
     World& world_;
     std::unique_ptr<DepNode> root_;
     MutMap<std::unique_ptr<DepNode>> mut2node_;
-    DefMap<VarSet> def2vars_;
+    /// Instead of the free Var%s themselves, we only remember the stack_ indices of their binding muts.
+    /// This works, as all binders of a Def's free Var%s are on the stack_ whenever we visit this Def - unless a Var is
+    /// ill-scoped or escapes its mut. See DepTree::binders for this case.
+    /// Only needed during construction.
+    DefMap<Memo> def2binders_;
     std::deque<DepNode*> stack_;
+    std::vector<size_t> stamps_; ///< DepTree::time_ when the corresponding stack_ entry has been pushed.
+    size_t time_ = 0;
 };
 
 } // namespace thorin
@@ -0,0 +1,78 @@
+#include "thorin/analyses/fingerprint.h"
+
+#include <cstring>
+
+#include <iomanip>
+
+#include "thorin/world.h"
+
+namespace thorin {
+
+Fingerprint& Fingerprint::add(World& world) {
+    // the order of Sym%s is not stable across runs
+    std::vector<std::pair<std::string, Def*>> externals;
+    for (const auto& [sym, mut] : world.externals()) externals.emplace_back(sym.str(), mut);
+    std::ranges::sort(externals, {}, [](const auto& p) { return p.first; });
+
+    for (const auto& [name, mut] : externals) add(name).add(hash(mut));
+
+    // hashing a mut's ops may discover further muts
+    for (size_t i = 0; i != muts_.size(); ++i) {
+        auto mut = muts_[i];
+        add(mut->node()).add(mut->flags()).add(hash(mut->type())).add(mut->num_ops());
+        // backends link these by name: e.g. an imported `puts` and `abort` of the same type must not collide
+        if (!mut->is_set() || mut->is_external() || mut->isa<Global>()) add(mut->sym().str());
+        for (auto op : mut->ops()) add(hash(op)); // unset ops yield 0
+    }
+
+    world.DLOG("fingerprint {}: {} muts, {} immutables", str(), muts_.size(), imm2hash_.size());
+    return *this;
+}
+
+Fingerprint& Fingerprint::add(std::string_view s) {
+    add(s.size());
+    for (auto c : s) add(u64(c));
+    return *this;
+}
+
+Fingerprint& Fingerprint::add_file(const fs::path& file) {
+    add(file.string());
+    MMap bin(file);
+    if (!bin) return add(~0_u64);
+
+    // shared objects are large: mix 8 bytes at a time
+    auto view = bin.view();
+    add(view.size());
+    size_t i = 0;
+    for (u64 word; i + sizeof(word) <= view.size(); i += sizeof(word)) {
+        std::memcpy(&word, view.data() + i, sizeof(word));
+        add(word);
+    }
+    for (; i != view.size(); ++i) add(u64(view[i]));
+    return *this;
+}
+
+std::string Fingerprint::str() const {
+    std::ostringstream os;
+    os << std::hex << std::setfill('0') << std::setw(16) << hash_;
+    return os.str();
+}
+
+u64 Fingerprint::hash(const Def* def) {
+    if (!def) return 0;
+
+    if (auto mut = def->isa_mut()) {
+        auto [i, inserted] = mut2index_.emplace(mut, mut2index_.size());
+        if (inserted) muts_.emplace_back(mut);
+        return mix(~0_u64, i->second); // mere reference; its content is hashed in Fingerprint::add
+    }
+
+    if (auto i = imm2hash_.find(def); i != imm2hash_.end()) return i->second;
+
+    auto h = mix(mix(0, def->node()), def->flags());
+    h      = mix(h, hash(def->type()));
+    for (auto op : def->ops()) h = mix(h, hash(op));
+    return imm2hash_[def] = h;
+}
+
+} // namespace thorin
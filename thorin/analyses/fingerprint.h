@@ -0,0 +1,50 @@
+#pragma once
+
+#include <deque>
+
+#include "thorin/def.h"
+
+#include "thorin/util/mmap.h"
+
+namespace thorin {
+
+/// Structural 64-bit hash of a World that - unlike Def::hash - is independent of Def::gid%s.
+/// Hence, it is stable across runs and serves as key for caches that persist on disk.
+/// Starting from the World::externals (sorted by name), muts are numbered in the order of their discovery;
+/// immutables are hashed by their node, flags, type, and ops.
+/// As backends refer to them by name, the Sym%s of unset and external muts as well as Global%s are hashed, too.
+/// Use Fingerprint::add to also take into account further data like World::flags.
+class Fingerprint {
+public:
+    Fingerprint() = default;
+    Fingerprint(World& world) { add(world); }
+
+    /// @name add
+    ///@{
+    Fingerprint& add(World&);
+    Fingerprint& add(std::string_view);
+    Fingerprint& add(u64 x) { return hash_ = mix(hash_, x), *this; }
+    /// Adds path and contents of @p file - e.g., a plugin's shared object - or merely its path if it can't be read.
+    Fingerprint& add_file(const fs::path& file);
+    ///@}
+
+    u64 get() const { return hash_; }
+    std::string str() const; ///< Hexadecimal representation.
+
+private:
+    static u64 mix(u64 h, u64 x) {
+        // scramble x first - FNV-1a on 64-bit words alone diffuses poorly
+        x *= 0x9e3779b97f4a7c15_u64;
+        x ^= x >> 32;
+        return (h ^ x) * 0x100000001b3_u64;
+    }
+
+    u64 hash(const Def*);
+
+    u64 hash_ = 0xcbf29ce484222325_u64;
+    DefMap<u64> imm2hash_;
+    MutMap<u64> mut2index_;
+    std::deque<Def*> muts_;
+};
+
+} // namespace thorin
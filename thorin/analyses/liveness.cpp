@@ -0,0 +1,68 @@
+#include "thorin/analyses/liveness.h"
+
+#include "thorin/world.h"
+
+#include "thorin/util/util.h"
+
+namespace thorin {
+
+BitSet LiveVars::transfer(const CFNode* n, const BitSet& out) const {
+    BitSet in = out;
+    in |= liveness->uses(n);
+    if (auto i = liveness->defs_[n]; i != size_t(-1)) in.clear(i);
+    return in;
+}
+
+Liveness::Liveness(const Scope& scope)
+    : scope_(scope)
+    , cfg_(scope.b_cfg())
+    , uses_(cfg_)
+    , defs_(cfg_, size_t(-1)) {
+    for (auto n : cfg().reverse_post_order()) {
+        auto mut = n->mut();
+        if (!mut->is_set()) continue;
+
+        auto& uses = uses_[n];
+        unique_queue<DefSet> queue;
+        auto enqueue = [&](const Def* def) {
+            if (def == nullptr || def->dep_const() || def->isa_mut() || !scope.bound(def)) return;
+            if (auto var = def->isa<Var>()) {
+                if (auto m = cfg().cfa()[var->mut()]) {
+                    auto [i, ins] = var2index_.emplace(var, vars_.size());
+                    if (ins) {
+                        vars_.emplace_back(var);
+                        defs_[m] = i->second;
+                    }
+                    uses.set(i->second);
+                }
+                return;
+            }
+            queue.push(def);
+        };
+
+        for (auto op : mut->ops()) enqueue(op);
+        while (!queue.empty())
+            for (auto op : queue.pop()->ops()) enqueue(op);
+    }
+
+    dataflow_ = std::make_unique<DataFlow<false, LiveVars>>(cfg(), LiveVars{this});
+}
+
+Liveness::~Liveness() {}
+
+size_t Liveness::index(const Var* var) const {
+    auto i = var2index_.find(var);
+    return i != var2index_.end() ? i->second : size_t(-1);
+}
+
+const BitSet& Liveness::live_in(const CFNode* n) const { return dataflow().out(n); }
+const BitSet& Liveness::live_out(const CFNode* n) const { return dataflow().in(n); }
+
+VarSet Liveness::vars(const BitSet& set) const {
+    VarSet result;
+    for (size_t i = 0, e = num_vars(); i != e; ++i)
+        if (set.test(i)) result.emplace(vars_[i]);
+    return result;
+}
+
+} // namespace thorin
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "thorin/analyses/dataflow.h"
+
+namespace thorin {
+
+class Liveness;
+
+/// The Lattice for Liveness: `live_in(n) = (uses(n) ∪ live_out(n)) \ defs(n)`.
+/// Note that a CFNode *defines* its mut's Var upon entry - hence `defs(n)` is removed last.
+struct LiveVars {
+    using Value = BitSet;
+
+    BitSet bottom() const { return {}; }
+    BitSet entry() const { return {}; }
+    BitSet transfer(const CFNode* n, const BitSet& out) const;
+
+    const Liveness* liveness = nullptr;
+};
+
+/// Computes which Var%s are *live* at the beginning (Liveness::live_in) and end (Liveness::live_out) of each CFNode.
+/// Only Var%s of the CFNode%s' muts are tracked; each one gets a dense index used in the resulting BitSet%s.
+/// A CFNode *uses* a Var if the Var is reachable from its mut's ops without entering another mut.
+/// This is a classic backward analysis running as DataFlow on the Scope's B_CFG.
+class Liveness {
+public:
+    Liveness(const Liveness&)     = delete;
+    Liveness& operator=(Liveness) = delete;
+
+    explicit Liveness(const Scope& scope);
+    ~Liveness();
+
+    /// @name Getters
+    ///@{
+    const Scope& scope() const { return scope_; }
+    const B_CFG& cfg() const { return cfg_; }
+    size_t num_vars() const { return vars_.size(); }
+    const Var* var(size_t i) const { return vars_[i]; }
+    size_t index(const Var* var) const; ///< Index of @p var in the BitSet%s or `size_t(-1)` if not tracked.
+    const BitSet& uses(const CFNode* n) const { return uses_[n]; }
+    const DataFlow<false, LiveVars>& dataflow() const { return *dataflow_; }
+    ///@}
+
+    /// @name Query Liveness
+    ///@{
+    const BitSet& live_in(const CFNode* n) const;
+    const BitSet& live_out(const CFNode* n) const;
+    bool is_live_in(const CFNode* n, const Var* var) const { return live_in(n).test(index(var)); }
+    bool is_live_out(const CFNode* n, const Var* var) const { return live_out(n).test(index(var)); }
+    /// Converts @p set back to Var%s.
+    VarSet vars(const BitSet& set) const;
+    ///@}
+
+private:
+    const Scope& scope_;
+    const B_CFG& cfg_;
+    std::vector<const Var*> vars_;
+    VarMap<size_t> var2index_;
+    B_CFG::Map<BitSet> uses_;
+    B_CFG::Map<size_t> defs_;
+    std::unique_ptr<DataFlow<false, LiveVars>> dataflow_;
+
+    friend struct LiveVars;
+};
+
+} // namespace thorin
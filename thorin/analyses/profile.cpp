@@ -0,0 +1,40 @@
+#include "thorin/analyses/profile.h"
+
+#include <charconv>
+
+#include "thorin/world.h"
+
+namespace thorin {
+
+void Profile::load(World& world, std::istream& is, std::string_view file) {
+    size_t num_lines = 0;
+    for (std::string line; std::getline(is, line);) {
+        ++num_lines;
+        if (line.empty()) continue;
+
+        u64 n          = 0;
+        auto end       = line.data() + line.size();
+        auto [ptr, ec] = std::from_chars(line.data(), end, n);
+        if (ec != std::errc() || ptr == end || *ptr != ' ' || ptr + 1 == end)
+            error("{}:{}: malformed profile entry '{}'; expected '<count> <id>'", file, num_lines, line);
+
+        auto& count = counts_[line.substr(ptr + 1 - line.data())];
+        count += n;
+        max_ = std::max(max_, count);
+    }
+
+    world.VLOG("profile: {} lines with {} ids; hottest: {}", num_lines, counts_.size(), max_);
+}
+
+std::string Profile::id(const Def* def) {
+    auto loc = def->loc();
+    if (!def->sym() || !loc || !loc.path) return {};
+    return fmt("{}@{}:{}:{}", def->sym(), loc.path->filename().string(), loc.begin.row, loc.begin.col);
+}
+
+std::optional<u64> Profile::count(const Def* def) const {
+    if (auto i = counts_.find(id(def)); i != counts_.end()) return i->second;
+    return {};
+}
+
+} // namespace thorin
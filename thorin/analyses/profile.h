@@ -0,0 +1,45 @@
+#pragma once
+
+#include <istream>
+#include <string>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "thorin/def.h"
+
+namespace thorin {
+
+/// Execution counts of Lam%s as gathered by running a program that has been compiled with Flags::instrument.
+/// Upon exit, such a program appends one line `<count> <name>` per basic block to the file given by the environment
+/// variable `THORIN_PROFILE` (default: `thorin.prof`); hence, several training runs accumulate.
+/// Counts are keyed by Profile::id which Lam::stub preserves; so they survive optimizations and map back to the
+/// freshly parsed program. Counts of copies of the same Lam add up.
+class Profile {
+public:
+    static constexpr u64 Hot_Ratio = 16; ///< A Lam is hot, if its count is at least 1/Hot_Ratio of the hottest.
+
+    /// Accumulates the counts from @p is which has been read from @p file.
+    void load(World&, std::istream& is, std::string_view file);
+    bool empty() const { return counts_.empty(); }
+
+    /// Identifies @p def across runs as `<sym>@<file>:<row>:<col>` of its declaration.
+    /// @returns an empty string, if @p def lacks a Sym or a Loc - such Lam%s are neither counted nor found.
+    static std::string id(const Def* def);
+
+    /// @name Query
+    /// A Lam whose Profile::id doesn't occur in the Profile is neither hot nor cold.
+    ///@{
+    std::optional<u64> count(const Def*) const;
+    bool is_hot(const Def* def) const {
+        auto n = count(def);
+        return n && *n != 0 && *n * Hot_Ratio >= max_;
+    }
+    bool is_cold(const Def* def) const { return count(def) == 0; }
+    ///@}
+
+private:
+    absl::flat_hash_map<std::string, u64> counts_;
+    u64 max_ = 0;
+};
+
+} // namespace thorin
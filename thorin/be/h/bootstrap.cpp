@@ -18,7 +18,8 @@ void bootstrap(Driver& driver, Sym plugin, std::ostream& h) {
     tab.print(h, "namespace thorin {{\nnamespace {} {{\n\n", plugin);
 
     plugin_t plugin_id = *Annex::mangle(plugin);
-    std::vector<std::ostringstream> normalizers, outer_namespace;
+    std::vector<std::ostringstream> outer_namespace;
+    std::vector<std::string> normalizers; // tag ↦ initializer of its Normalizers::Table row
 
     tab.print(h << std::hex, "static constexpr plugin_t Plugin_Id = 0x{};\n\n", plugin_id);
 
@@ -42,19 +43,22 @@ void bootstrap(Driver& driver, Sym plugin, std::ostream& h) {
         auto& os = outer_namespace.emplace_back();
         print(os << std::hex, "template<> constexpr flags_t Annex::Base<{}::{}> = 0x{};\n", plugin, ax.tag, ax_id);
 
+        std::ostringstream row;
         if (auto& subs = ax.subs; !subs.empty()) {
             for (const auto& aliases : subs) {
                 const auto& sub = aliases.front();
                 tab.print(h, "{} = 0x{},\n", sub, ax_id++);
                 for (size_t i = 1; i < aliases.size(); ++i) tab.print(h, "{} = {},\n", aliases[i], sub);
 
-                if (ax.normalizer)
-                    print(normalizers.emplace_back(), "normalizers[flags_t({}::{})] = &{}<{}::{}>;", ax.tag, sub,
-                          ax.normalizer, ax.tag, sub);
+                if (ax.normalizer) print(row, "&{}<{}::{}>, ", ax.normalizer, ax.tag, sub);
             }
         } else {
-            if (ax.normalizer)
-                print(normalizers.emplace_back(), "normalizers[flags_t(Annex::Base<{}>)] = &{};", ax.tag, ax.normalizer);
+            if (ax.normalizer) print(row, "&{}", ax.normalizer);
+        }
+
+        if (ax.normalizer) {
+            if (normalizers.size() <= ax.tag_id) normalizers.resize(ax.tag_id + 1);
+            normalizers[ax.tag_id] = row.str();
         }
         --tab;
         tab.print(h, "}};\n\n");
@@ -79,7 +83,11 @@ void bootstrap(Driver& driver, Sym plugin, std::ostream& h) {
         ++tab;
         tab.print(h, "void register_normalizers(Normalizers& normalizers) {{\\\n");
         ++tab;
-        for (const auto& normalizer : normalizers) tab.print(h, "{} \\\n", normalizer.str());
+        tab.print(h, "normalizers.add(Plugin_Id, {{\\\n");
+        ++tab;
+        for (const auto& row : normalizers) tab.print(h, "{{{}}}, \\\n", row);
+        --tab;
+        tab.print(h, "}}); \\\n");
         --tab;
         tab.print(h, "}}\n");
         --tab;
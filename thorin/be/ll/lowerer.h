@@ -0,0 +1,70 @@
+#pragma once
+
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "thorin/def.h"
+
+#include "thorin/util/print.h"
+
+namespace thorin::ll {
+
+/// Interface of the LLVM backend for the lowering rules of the Plugin%s.
+/// A Plugin registers a rule for each of its Axiom%s via Plugin::register_lowerings.
+/// The backend invokes the rule for a fully applied Axiom which, in turn, emits textual LLVM IR through this interface
+/// into the current basic block.
+class Lowerer {
+public:
+    virtual ~Lowerer() = default;
+
+    /// @name Emit
+    ///@{
+    /// Recursively emits @p def and yields its LLVM value; asserts that there is one - i.e., @p def is no `%mem.M`.
+    virtual std::string emit(const Def* def) = 0;
+    /// As above but yields the empty string for `%mem.M`-typed @p def%s.
+    virtual std::string emit_unsafe(const Def* def) = 0;
+    /// Yields the LLVM type of @p type.
+    virtual std::string convert(const Def* type) = 0;
+    /// Yields LLVM value and type of @p index, extended such that `getelementptr` doesn't consider it signed.
+    virtual std::pair<std::string, std::string> gep_index(const Def* index, const std::string& name) = 0;
+    /// Yields the LLVM instruction for `f (a, b)`, if @p f is an element-wise binary operation.
+    virtual std::optional<std::string> binop(Ref f) = 0;
+    /// Yields a `!tbaa` attachment for accessing @p ptr or the empty string.
+    virtual std::string tbaa(const Def* ptr) = 0;
+    ///@}
+
+    /// @name Instructions
+    /// Append to the current basic block.
+    ///@{
+    template<class... Args> std::string assign(std::string_view name, const char* s, Args&&... args) {
+        print(line() << name << " = ", s, std::forward<Args&&>(args)...);
+        commit(Part::Body);
+        return std::string(name);
+    }
+    template<class... Args> void body(const char* s, Args&&... args) {
+        print(line(), s, std::forward<Args&&>(args)...);
+        commit(Part::Body);
+    }
+    template<class... Args> void tail(const char* s, Args&&... args) {
+        print(line(), s, std::forward<Args&&>(args)...);
+        commit(Part::Tail);
+    }
+    /// Declares an external function - e.g. an LLVM intrinsic - once per module.
+    template<class... Args> void declare(const char* s, Args&&... args) {
+        std::ostringstream decl;
+        print(decl << "declare ", s, std::forward<Args&&>(args)...);
+        add_declaration(decl.str());
+    }
+    ///@}
+
+protected:
+    enum class Part { Body, Tail };
+
+    virtual std::ostream& line()                   = 0; ///< Starts a new instruction.
+    virtual void commit(Part)                      = 0; ///< Appends the instruction started by Lowerer::line.
+    virtual void add_declaration(std::string decl) = 0;
+};
+
+} // namespace thorin::ll
@@ -75,6 +75,35 @@ bool Infer::eliminate(Vector<Ref*> refs) {
  * Check
  */
 
+hash_t Check::hash(Ref ref) {
+    auto def = *ref;
+    if (!def) return hash_begin();
+
+    auto& hashes = world().move_.check_hashes;
+    if (auto i = hashes.find(def); i != hashes.end()) return i->second;
+
+    hash_t h = 0;
+    if (!def->isa<Tuple, Pack, Sigma, Arr>()) {
+        if (def->isa_mut() || def->isa<Var, Lam, Pi>()) { // Lam%s and Pi%s may be compared against muts
+            h = hash_begin(def->node());
+        } else {
+            h = hash_combine(hash_begin(def->node()), def->flags(), def->num_ops());
+            for (auto op : def->ops()) {
+                auto o = hash(op);
+                if (o == 0) {
+                    h = 0;
+                    break;
+                }
+                h = hash_combine(h, o);
+            }
+        }
+        if (h == 0) h = 1; // 0 is reserved for "don't know"
+    }
+
+    if (hashes.size() >= Max_Hashes) hashes.clear();
+    return hashes[def] = h;
+}
+
 #ifdef THORIN_ENABLE_CHECKS
 template<bool infer> bool Check::fail() {
     if (infer && world().flags().break_on_alpha_unequal) fe::breakpoint();
@@ -86,13 +115,15 @@ template<bool infer> bool Check::alpha_(Ref r1, Ref r2) {
     auto d1 = *r1; // find
     auto d2 = *r2; // find
 
+    auto& stats = world().state_.check_stats;
+    ++stats.checks;
     if (!d1 && !d2) return true;
     if (!d1 || !d2) return fail<infer>();
 
     // It is only safe to check for pointer equality if there are no Vars involved.
-    // Otherwise, we have to look more thoroughly.
+    // Otherwise, we have to look more thoroughly - unless we didn't descend into any binder yet.
     // Example: λx.x - λz.x
-    if (!d1->has_dep(Dep::Var) && !d2->has_dep(Dep::Var) && d1 == d2) return true;
+    if (d1 == d2 && (vars_.empty() || (!d1->has_dep(Dep::Var) && !d2->has_dep(Dep::Var)))) return true;
     auto mut1 = d1->isa_mut();
     auto mut2 = d2->isa_mut();
     if (mut1 && mut2 && mut1 == mut2) return true;
@@ -100,6 +131,13 @@ template<bool infer> bool Check::alpha_(Ref r1, Ref r2) {
     // Unless they are pointer equal (above) always consider them unequal.
     if (d1->isa<Global>() || d2->isa<Global>()) return false;
 
+    if (!infer && !d1->has_dep(Dep::Infer) && !d2->has_dep(Dep::Infer)) {
+        if (auto h1 = hash(d1), h2 = hash(d2); h1 != 0 && h2 != 0 && h1 != h2) {
+            ++stats.hash_rejects;
+            return fail<infer>();
+        }
+    }
+
     if (mut1) {
         if (auto [i, ins] = done_.emplace(mut1, d2); !ins) return i->second == d2;
     }
@@ -134,7 +172,16 @@ template<bool infer> bool Check::alpha_(Ref r1, Ref r2) {
         || (d1->gid() > d2->gid()))              // smaller gid to left
         std::swap(d1, d2);
 
-    return alpha_internal<infer>(d1, d2);
+    if (mut1 || mut2) return alpha_internal<infer>(d1, d2); // muts are memoized via done_
+
+    if (auto i = equal_.find({d1, d2}); i != equal_.end() && (infer || !i->second)) {
+        ++stats.memo_hits;
+        return true;
+    }
+
+    if (!alpha_internal<infer>(d1, d2)) return false;
+    if (auto [i, ins] = equal_.emplace(DefDef(d1, d2), infer); !ins) i->second &= infer;
+    return true;
 }
 
 template<bool infer> bool Check::alpha_internal(Ref d1, Ref d2) {
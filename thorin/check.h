@@ -45,6 +45,16 @@ private:
 
 class Check {
 public:
+    /// Counters for Check::alpha; accumulated in World::check_stats.
+    struct Stats {
+        size_t checks       = 0; ///< Pairs compared in total.
+        size_t memo_hits    = 0; ///< Pairs already proven to be α-equivalent before - within the same query.
+        size_t hash_rejects = 0; ///< Pairs rejected due to different Check::hash%es.
+    };
+
+    /// The World-wide cache of Check::hash%es is flushed once it exceeds this many entries.
+    static constexpr size_t Max_Hashes = 1 << 16;
+
     Check(World& world)
         : world_(world) {}
 
@@ -75,10 +85,20 @@ private:
     template<bool infer> bool alpha_internal(Ref, Ref);
     bool assignable_(Ref type, Ref value);
 
+    /// Structural hash modulo α-renaming: Var%s, Lam%s, Pi%s, and muts are only hashed by their node.
+    /// Different hashes imply that two Def%s are **not** α-equivalent - if not in `infer` mode.
+    /// A Tuple, Pack, Sigma, or Arr may be compared projection-wise against *any* other Def.
+    /// So, we can't say anything if one of those is involved and yield `0` in this case.
+    /// As it doesn't depend on the query, the result is cached in the World.
+    hash_t hash(Ref);
+
     World& world_;
     using Vars = MutMap<Def*>;
     Vars vars_;
     MutMap<Ref> done_;
+    /// Pairs proven to be α-equivalent in this query; `true` if only in `infer` mode.
+    /// Pairs with Var%s may only be proven under the binders in Check::vars_ - hence, this memo doesn't outlive a query.
+    DefDefMap<bool> equal_;
 };
 
 } // namespace thorin
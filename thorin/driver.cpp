@@ -1,13 +1,30 @@
 #include "thorin/driver.h"
 
+#include <chrono>
+
 #include "thorin/plugin.h"
 
 #include "thorin/util/dl.h"
 #include "thorin/util/sys.h"
 
+#ifndef _WIN32
+#    include <sys/stat.h>
+#endif
+
 namespace thorin {
 
 namespace {
+/// Identifies the file @p path refers to - like `fs::equivalent` does but with a single `stat`.
+std::string file_id(const fs::path& path) {
+#ifndef _WIN32
+    struct stat st;
+    if (::stat(path.c_str(), &st) == 0) return fmt("{}:{}", st.st_dev, st.st_ino);
+#endif
+    std::error_code ec;
+    if (auto canonical = fs::weakly_canonical(path, ec); !ec) return canonical.string();
+    return path.lexically_normal().string();
+}
+
 std::vector<fs::path> get_plugin_name_variants(std::string_view name) {
     std::vector<fs::path> names;
     names.push_back(name); // if the user gives "libthorin_foo.so"
@@ -42,9 +59,24 @@ Driver::Driver()
     insert_ = ++search_paths_.begin();
 }
 
+fs::path Driver::find_import(const fs::path& name) {
+    auto [i, ins] = name2import_.emplace(name.string(), fs::path());
+    if (!ins) return i->second;
+
+    auto filename = name;
+    if (!filename.has_extension()) filename.replace_extension("thorin"); // TODO error cases
+
+    auto& res = i->second;
+    for (const auto& path : search_paths()) {
+        res = path / filename;
+        std::error_code ignore;
+        if (bool reg_file = fs::is_regular_file(res, ignore); reg_file && !ignore) break;
+    }
+    return res;
+}
+
 const fs::path* Driver::add_import(fs::path path, Sym sym) {
-    for (const auto& [p, _] : imports_)
-        if (fs::equivalent(p, path)) return nullptr;
+    if (!import_ids_.emplace(file_id(path)).second) return nullptr;
 
     imports_.emplace_back(std::pair(std::move(path), sym));
     return &imports_.back().first;
@@ -58,34 +90,45 @@ void Driver::load(Sym name) {
         return;
     }
 
+    auto begin    = std::chrono::steady_clock::now();
+    auto get_info = static_plugin(name.view());
     Plugin::Handle handle{nullptr, dl::close};
-    if (auto path = fs::path{name.view()}; path.is_absolute() && fs::is_regular_file(path))
-        handle.reset(dl::open(name));
-    if (!handle) {
-        for (const auto& path : search_paths()) {
-            for (auto name_variants = get_plugin_name_variants(name); const auto& name_variant : name_variants) {
-                auto full_path = path / name_variant;
-                std::error_code ignore;
-                if (bool reg_file = fs::is_regular_file(full_path, ignore); reg_file && !ignore) {
-                    auto path_str = full_path.string();
-                    if (handle.reset(dl::open(path_str.c_str())); handle) break;
+    if (!get_info) {
+        if (auto path = fs::path{name.view()}; path.is_absolute() && fs::is_regular_file(path)) {
+            if (handle.reset(dl::open(name)); handle) plugin_files_.emplace_back(path);
+        }
+        if (!handle) {
+            for (const auto& path : search_paths()) {
+                for (auto name_variants = get_plugin_name_variants(name); const auto& name_variant : name_variants) {
+                    auto full_path = path / name_variant;
+                    std::error_code ignore;
+                    if (bool reg_file = fs::is_regular_file(full_path, ignore); reg_file && !ignore) {
+                        auto path_str = full_path.string();
+                        if (handle.reset(dl::open(path_str.c_str())); handle) {
+                            plugin_files_.emplace_back(full_path);
+                            break;
+                        }
+                    }
                 }
+                if (handle) break;
             }
-            if (handle) break;
         }
+
+        if (!handle) error("cannot open plugin '{}'", name);
+        get_info = reinterpret_cast<GetPlugin>(dl::get(handle.get(), "thorin_get_plugin"));
+        if (!get_info) error("plugin has no 'thorin_get_plugin()'");
     }
 
-    if (!handle) error("cannot open plugin '{}'", name);
+    bool linked = !handle;
+    assert_emplace(plugins_, name, std::move(handle));
+    auto info = get_info();
+    if (auto reg = info.register_passes) reg(passes_);
+    if (auto reg = info.register_normalizers) reg(normalizers_);
+    if (auto reg = info.register_backends) reg(backends_);
+    if (auto reg = info.register_lowerings) reg(lowerings_);
 
-    if (auto get_info = reinterpret_cast<decltype(&thorin_get_plugin)>(dl::get(handle.get(), "thorin_get_plugin"))) {
-        assert_emplace(plugins_, name, std::move(handle));
-        auto info = get_info();
-        if (auto reg = info.register_passes) reg(passes_);
-        if (auto reg = info.register_normalizers) reg(normalizers_);
-        if (auto reg = info.register_backends) reg(backends_);
-    } else {
-        error("plugin has no 'thorin_get_plugin()'");
-    }
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+    VLOG("loaded plugin '{}' in {}us ({})", name, us.count(), linked ? "statically linked" : "dlopen");
 }
 
 std::pair<Annex&, bool> Driver::name2annex(Sym sym, Sym plugin, Sym tag, Loc loc) {
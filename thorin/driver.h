@@ -6,6 +6,9 @@
 #include "thorin/plugin.h"
 #include "thorin/world.h"
 
+#include "thorin/analyses/profile.h"
+
+#include "thorin/util/cache.h"
 #include "thorin/util/log.h"
 
 #include "absl/container/node_hash_map.h"
@@ -23,6 +26,10 @@ public:
     Flags& flags() { return flags_; }
     Log& log() { return log_; }
     World& world() { return world_; }
+    Profile& profile() { return profile_; } ///< Empty, unless a Profile has been loaded.
+    /// On-disk Cache that backends may use to persist expensive results across runs; `nullptr` if there is none.
+    Cache* cache() { return cache_; }
+    void set(Cache* cache) { cache_ = cache; }
     ///@}
 
     /// @name Manage Search Paths
@@ -35,8 +42,14 @@ public:
     /// 5. `CMAKE_INSTALL_PREFIX/lib/thorin`
     const auto& search_paths() const { return search_paths_; }
     void add_search_path(fs::path path) {
-        if (fs::exists(path) && fs::is_directory(path)) search_paths_.insert(insert_, std::move(path));
+        if (fs::exists(path) && fs::is_directory(path)) {
+            search_paths_.insert(insert_, std::move(path));
+            name2import_.clear();
+        }
     }
+    /// Looks for the file of `.import` @p name in Driver::search_paths; results are cached.
+    /// If no such file exists, the candidate in the last search path is returned.
+    fs::path find_import(const fs::path& name);
     ///@}
 
     /// @name Manage Imports
@@ -46,6 +59,7 @@ public:
     /// 2. The name as Sym%bol used in the `.import` directive or in Parser::import.
     const auto& imports() { return imports_; }
     /// Yields a `fs::path*` if not already added that you can use in Loc%ation; returns `nullptr` otherwise.
+    /// Files are identified by device and inode - or by their canonical path where these are not available.
     const fs::path* add_import(fs::path, Sym);
     ///@}
 
@@ -58,15 +72,18 @@ public:
     void load(Sym name);
     void load(const std::string& name) { return load(sym(name)); }
     bool is_loaded(Sym sym) const { return lookup(plugins_, sym); }
+    /// Shared object files of all plugins loaded so far - in order; statically linked plugins don't have one.
+    const auto& plugin_files() const { return plugin_files_; }
     ///@}
 
     /// @name Manage Plugins
     ///@{
     /// All these lookups yield `nullptr` if the key has not been found.
     auto pass(flags_t flags) { return lookup(passes_, flags); }
-    auto normalizer(flags_t flags) const { return lookup(normalizers_, flags); }
+    auto normalizer(flags_t flags) const { return normalizers_.find(flags); }
     auto normalizer(plugin_t d, tag_t t, sub_t s) const { return normalizer(d | flags_t(t << 8u) | s); }
     auto backend(std::string_view name) { return lookup(backends_, name); }
+    auto lowering(flags_t base) const { return lookup(lowerings_, base); }
     ///@}
 
     /// @name Manage Annex
@@ -79,13 +96,19 @@ private:
     Flags flags_;
     Log log_;
     World world_;
+    Profile profile_;
+    Cache* cache_ = nullptr;
     std::list<fs::path> search_paths_;
     std::list<fs::path>::iterator insert_ = search_paths_.end();
     absl::node_hash_map<Sym, Plugin::Handle> plugins_;
+    std::vector<fs::path> plugin_files_;
     Backends backends_;
+    Lowerings lowerings_;
     Passes passes_;
     Normalizers normalizers_;
     std::deque<std::pair<fs::path, Sym>> imports_;
+    absl::flat_hash_set<std::string> import_ids_;
+    absl::flat_hash_map<std::string, fs::path> name2import_;
     fe::SymMap<fe::SymMap<Annex>> plugin2annexes_;
 };
 
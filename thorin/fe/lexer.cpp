@@ -1,5 +1,7 @@
 #include "thorin/fe/lexer.h"
 
+#include <array>
+
 #include "thorin/world.h"
 
 using namespace std::literals;
@@ -9,10 +11,33 @@ namespace thorin {
 namespace utf8 = fe::utf8;
 using Tag      = Tok::Tag;
 
-Lexer::Lexer(World& world, std::istream& istream, const fs::path* path /*= nullptr*/, std::ostream* md /*= nullptr*/)
+namespace {
+/// @name ASCII Fast Path
+/// Most Thorin code is ASCII; the Unicode-aware predicates of fe::utf8 are only consulted beyond that.
+///@{
+enum : u8 { Space = 1 << 0, Id_Start = 1 << 1, Id = 1 << 2 };
+
+constexpr auto Ascii = [] {
+    std::array<u8, 128> classes = {};
+    for (char c : {' ', '\t', '\n', '\v', '\f', '\r'}) classes[c] = Space;
+    for (char c = 'a'; c <= 'z'; ++c) classes[c] = Id_Start | Id;
+    for (char c = 'A'; c <= 'Z'; ++c) classes[c] = Id_Start | Id;
+    for (char c = '0'; c <= '9'; ++c) classes[c] = Id;
+    classes['_'] = Id_Start | Id;
+    classes['.'] = Id;
+    return classes;
+}();
+
+bool is(char32_t c, u8 cls) { return c < Ascii.size() && (Ascii[c] & cls); }
+bool is_id_start(char32_t c) { return c < Ascii.size() ? is(c, Id_Start) : utf8::isalpha(c); }
+bool is_id(char32_t c) { return c < Ascii.size() ? is(c, Id) : utf8::isalnum(c); }
+///@}
+} // namespace
+
+Lexer::Lexer(World& world, std::istream& istream, const fs::path* path /*= nullptr*/, bool docs /*= false*/)
     : Super(istream, path)
     , world_(world)
-    , md_(md) {
+    , docs_(docs) {
 #define CODE(t, str) keywords_[world.sym(str)] = Tag::t;
     THORIN_KEY(CODE)
 #undef CODE
@@ -21,11 +46,6 @@ Lexer::Lexer(World& world, std::istream& istream, const fs::path* path /*= nullp
     if (Tag::t != Tag::Nil) keywords_[world.sym(str)] = Tag::t;
     THORIN_SUBST(CODE)
 #undef CODE
-
-    if (start_md())
-        emit_md(true);
-    else
-        md_fence();
 }
 
 Tok Lexer::lex() {
@@ -37,6 +57,17 @@ Tok Lexer::lex() {
 
         start();
 
+        // skip whitespace in one go and don't test identifiers against all other tokens first
+        if (is(ahead(), Space)) {
+            while (is(ahead(), Space)) next();
+            continue;
+        }
+        if (is(ahead(), Id_Start)) {
+            lex_id();
+            auto loc = cache_trailing_dot();
+            return {loc, Tag::M_id, sym()};
+        }
+
         if (accept(utf8::EoF)) return tok(Tag::EoF);
         if (accept(utf8::isspace)) continue;
         if (accept(utf8::Null)) error(loc_, "invalid UTF-8 character");
@@ -147,7 +178,8 @@ Tok Lexer::lex() {
         }
 
         if (start_md()) {
-            emit_md();
+            lex_doc();
+            if (docs_) return {loc_, Tag::M_doc, sym()};
             continue;
         }
 
@@ -166,8 +198,8 @@ Tok Lexer::lex() {
             continue;
         }
 
-        error({loc_.path, peek_}, "invalid input char '{}'", utf8::Char32(ahead()));
-        next();
+        auto pos = peek_;
+        error({loc_.path, pos}, "invalid input char '{}'", utf8::Char32(next())); // consume it for Parser::recover
     }
 }
 
@@ -184,8 +216,8 @@ Loc Lexer::cache_trailing_dot() {
 }
 
 bool Lexer::lex_id() {
-    if (accept([](char32_t c) { return c == '_' || utf8::isalpha(c); })) {
-        while (accept([](char32_t c) { return c == '_' || c == '.' || utf8::isalnum(c); })) {}
+    if (accept(is_id_start)) {
+        while (accept(is_id)) {}
         return true;
     }
     return false;
@@ -327,23 +359,14 @@ void Lexer::eat_comments() {
     }
 }
 
-void Lexer::emit_md(bool start_of_file) {
-    if (!start_of_file) md_fence();
-
+// Consumes a run of `///` lines and keeps their text - sans `/// ` - in str_.
+void Lexer::lex_doc() {
     do {
-        out_ = false;
         for (int i = 0; i < 3; ++i) next();
-        accept(' ');
-        out_ = true;
-
-        while (ahead() != utf8::EoF && ahead() != '\n') next();
+        accept<Append::Off>(' ');
+        while (accept([](char32_t c) { return c != utf8::EoF && c != '\n'; })) {}
         accept('\n');
     } while (start_md());
-
-    if (ahead() == utf8::EoF)
-        out_ = false;
-    else
-        md_fence();
 }
 
 Sym Lexer::sym() { return world().sym(str_); }
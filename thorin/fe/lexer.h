@@ -16,8 +16,8 @@ class Lexer : public fe::Lexer<3, Lexer> {
 
 public:
     /// Creates a lexer to read Thorin files (see [Lexical Structure](@ref lex)).
-    /// If @p md is not `nullptr`, a Markdown output will be generated.
-    Lexer(World& world, std::istream& istream, const fs::path* path = nullptr, std::ostream* md = nullptr);
+    /// `///` doc comments are usually skipped like any other comment; with @p docs they are yielded as Tok::Tag::M_doc.
+    Lexer(World& world, std::istream& istream, const fs::path* path = nullptr, bool docs = false);
 
     World& world() { return world_; }
     const fs::path* path() const { return loc_.path; }
@@ -25,20 +25,6 @@ public:
     Tok lex();
 
 private:
-    char32_t next() {
-        auto res = Super::next();
-        if (md_ && out_) {
-            if (res == fe::utf8::EoF) {
-                *md_ << "\n```\n";
-                out_ = false;
-            } else if (res) {
-                bool success = fe::utf8::encode(*md_, res);
-                assert_unused(success);
-            }
-        }
-        return res;
-    }
-
     Tok tok(Tok::Tag tag) { return {loc(), tag}; }
     Sym sym();
     Loc cache_trailing_dot();
@@ -49,14 +35,10 @@ private:
     bool parse_exp(int base = 10);
     void eat_comments();
     bool start_md() const { return ahead(0) == '/' && ahead(1) == '/' && ahead(2) == '/'; }
-    void emit_md(bool start_of_file = false);
-    void md_fence() {
-        if (md_) *md_ << "```\n";
-    }
+    void lex_doc();
 
     World& world_;
-    std::ostream* md_;
-    bool out_ = true;
+    bool docs_;
     fe::SymMap<Tok::Tag> keywords_;
     std::optional<Tok> cache_ = std::nullopt;
 
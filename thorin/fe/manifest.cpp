@@ -0,0 +1,32 @@
+#include "thorin/fe/manifest.h"
+
+#include <set>
+
+#include "thorin/analyses/fingerprint.h"
+
+namespace thorin {
+
+u64 Manifest::hash(const std::string& name) const {
+    std::set<std::string> closure; // sorted - hence, deterministic
+    std::vector<std::string> todo{name};
+    while (!todo.empty()) {
+        auto curr = std::move(todo.back());
+        todo.pop_back();
+        if (auto i = decls.find(curr); i != decls.end() && closure.emplace(curr).second)
+            todo.insert(todo.end(), i->second.deps.begin(), i->second.deps.end());
+    }
+
+    Fingerprint fp;
+    for (const auto& n : closure) fp.add(n).add(decls.at(n).hash);
+    return fp.get();
+}
+
+u64 Manifest::key() const {
+    Fingerprint fp;
+    fp.add(header);
+    for (const auto& [name, decl] : decls)
+        if (decl.external) fp.add(name).add(hash(name));
+    return fp.get();
+}
+
+} // namespace thorin
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "thorin/util/types.h"
+
+namespace thorin {
+
+/// Summary of the top-level declarations of a module as computed by Parser::manifest - without elaborating anything.
+/// A Decl is named after the first identifier it binds and hashed by its Tok%ens; so comments and whitespace don't
+/// matter. Manifest::key serves as cache key that is available before parsing: A changed key recompiles the whole
+/// module while edits to Decl%s that no external depends on leave it alone.
+class Manifest {
+public:
+    struct Decl {
+        u64 hash      = 0;
+        bool external = false;
+        std::vector<std::string> deps; ///< Other top-level Decl%s mentioned by this one.
+    };
+
+    /// Hash of everything the Decl%s implicitly depend on: the `.import`/`.plugin` directives, the contents of all
+    /// imported files, the shared object files of all loaded plugins (see Driver::plugin_files), and all `.ax` and
+    /// annex declarations.
+    u64 header = 0;
+    std::map<std::string, Decl> decls;
+
+    /// @name Hashes
+    ///@{
+    u64 hash(const std::string& name) const; ///< Hash of @p name's Decl and all Decl%s it transitively depends on.
+    u64 key() const; ///< Combines Manifest::header and Manifest::hash of all externals - the output only depends on it.
+    ///@}
+};
+
+} // namespace thorin
@@ -0,0 +1,50 @@
+#include "thorin/fe/md.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "thorin/fe/lexer.h"
+
+namespace thorin {
+
+void emit_md(World& world, std::string_view src, const fs::path* path, std::ostream& md) {
+    std::vector<size_t> rows{0}; // offset of each row's first byte
+    for (size_t i = 0, e = src.size(); i != e; ++i)
+        if (src[i] == '\n') rows.emplace_back(i + 1);
+
+    // Loc%s count code points starting at 1
+    auto offset = [&](Pos pos) {
+        auto i = rows[pos.row - 1];
+        for (auto col = pos.col; col > 1 && i < src.size(); --col)
+            while (++i < src.size() && (src[i] & 0xc0) == 0x80) {} // skip UTF-8 continuation bytes
+        return i;
+    };
+
+    std::istringstream is{std::string(src)};
+    auto lexer = Lexer(world, is, path, true);
+    size_t done = 0;
+    bool code   = !src.starts_with("///");
+    if (code) md << "```\n";
+
+    for (auto tok = lexer.lex(); !tok.isa(Tok::Tag::EoF); tok = lexer.lex()) {
+        if (!tok.isa(Tok::Tag::M_doc)) continue;
+
+        auto begin = offset(tok.loc().begin);
+        auto prose = tok.sym().view();
+        md << src.substr(done, begin - done);
+        if (code) md << "```\n";
+        md << prose;
+
+        auto lines = std::ranges::count(prose, '\n');
+        done       = prose.ends_with('\n') ? rows[tok.loc().begin.row - 1 + lines] : src.size();
+        code       = done != src.size();
+        if (code) md << "```\n";
+    }
+
+    md << src.substr(done);
+    if (code) md << "\n```\n";
+}
+
+} // namespace thorin
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <filesystem>
+#include <ostream>
+#include <string_view>
+
+namespace thorin {
+
+namespace fs = std::filesystem;
+
+class World;
+
+/// Renders the Thorin module @p src as Markdown to @p md (see `--output-md`):
+/// Each run of `///` doc comments becomes prose while everything else goes verbatim into code fences.
+/// The doc comments are taken from the Tok%en stream of a dedicated Lexer; so ordinary lexing doesn't pay for this.
+void emit_md(World& world, std::string_view src, const fs::path* path, std::ostream& md);
+
+} // namespace thorin
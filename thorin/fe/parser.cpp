@@ -1,9 +1,15 @@
 #include "thorin/fe/parser.h"
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
 #include <filesystem>
-#include <fstream>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <span>
 #include <sstream>
+#include <thread>
 #include <variant>
 
 #include "thorin/check.h"
@@ -11,6 +17,11 @@
 #include "thorin/driver.h"
 #include "thorin/rewrite.h"
 
+#include "thorin/analyses/fingerprint.h"
+
+#include "thorin/fe/md.h"
+
+#include "thorin/util/mmap.h"
 #include "thorin/util/sys.h"
 
 using namespace std::string_literals;
@@ -19,52 +30,336 @@ namespace thorin {
 
 using Tag = Tok::Tag;
 
+namespace {
+/// Yields the names in the leading `.import`/`.plugin` directives of @p src without lexing it in full.
+/// Parser::parse_module only accepts these directives at the beginning of a file.
+/// The names of `.plugin` directives are also added to @p plugins, if given.
+std::vector<std::string> scan_imports(std::string_view src, std::vector<std::string>* plugins = nullptr) {
+    std::vector<std::string> res;
+    size_t i = 0, n = src.size();
+    auto skip = [&] {
+        while (i != n) {
+            if (std::isspace((unsigned char)src[i])) {
+                ++i;
+            } else if (src.substr(i, 2) == "//") {
+                while (i != n && src[i] != '\n') ++i;
+            } else if (src.substr(i, 2) == "/*") {
+                auto end = src.find("*/", i + 2);
+                i        = end == std::string_view::npos ? n : end + 2;
+            } else {
+                break;
+            }
+        }
+    };
+
+    while (true) {
+        skip();
+        if (src.substr(i, 7) != ".import" && src.substr(i, 7) != ".plugin") break;
+        bool plugin = src.substr(i, 7) == ".plugin";
+        i += 7;
+        skip();
+        auto begin = i;
+        while (i != n && (std::isalnum((unsigned char)src[i]) || src[i] == '_' || src[i] == '.')) ++i;
+        if (begin == i) break;
+        res.emplace_back(src.substr(begin, i - begin));
+        if (plugin && plugins) plugins->emplace_back(res.back());
+        skip();
+        if (i == n || src[i++] != ';') break;
+    }
+
+    return res;
+}
+
+/// Parser::recover resumes at these - unless they are nested in delimiters; see delim_nesting.
+bool is_decl_start(Tag tag) {
+    switch (tag) {
+        case Tag::K_ax:
+        case Tag::K_let:
+        case Tag::K_Sigma:
+        case Tag::K_Pi:
+        case Tag::K_con:
+        case Tag::K_fun:
+        case Tag::K_lam: return true;
+        default: return false;
+    }
+}
+
+/// How @p tag changes the nesting of declarations: Each of these keywords starts a construct that ends with a ';' -
+/// stray semicolons aside.
+int decl_nesting(Tag tag, Tag prev) {
+    switch (tag) {
+        case Tag::K_ax:
+        case Tag::K_let:
+        case Tag::K_ret:
+        case Tag::K_Sigma:
+        case Tag::K_Pi:
+        case Tag::K_con:
+        case Tag::K_fun:
+        case Tag::K_lam: return 1;
+        case Tag::T_semicolon: return prev == Tag::T_semicolon ? 0 : -1;
+        default: return 0;
+    }
+}
+
+/// How @p tag changes the nesting of delimiters like `(`, `[`, or `{`.
+int delim_nesting(Tag tag) {
+    switch (tag) {
+        case Tag::D_angle_l:
+        case Tag::D_brace_l:
+        case Tag::D_brckt_l:
+        case Tag::D_paren_l:
+        case Tag::D_quote_l: return 1;
+        case Tag::D_angle_r:
+        case Tag::D_brace_r:
+        case Tag::D_brckt_r:
+        case Tag::D_paren_r:
+        case Tag::D_quote_r: return -1;
+        default: return 0;
+    }
+}
+} // namespace
+
+/*
+ * error recovery
+ */
+
+int Parser::nesting() {
+    auto res = source_.nesting;
+    for (size_t i = 0; i != Look_Ahead; ++i) res -= delim_nesting(ahead(i).tag()); // not consumed yet
+    return res;
+}
+
+template<class F> void Parser::recover(F f) {
+    if (!driver().flags().recover) return f();
+
+    auto begin = ahead().loc().begin;
+    auto level = nesting();
+    auto moved = [&] { return ahead().loc().begin.row != begin.row || ahead().loc().begin.col != begin.col; };
+    for (bool skip = false;; skip = true) {
+        try {
+            if (!skip) return f();
+            if (!moved() && !ahead().isa(Tag::EoF)) lex(); // always make progress
+            // declarations nested in, e.g., the body of a function belong to the erroneous one
+            while (!ahead().isa(Tag::EoF) && (nesting() > level || !is_decl_start(ahead().tag()))) lex();
+            return;
+        } catch (const std::exception& e) {
+            errors_.emplace_back(e.what());
+            scopes_.unwind();
+        }
+    }
+}
+
 /*
  * entry points
  */
 
 void Parser::parse_module() {
-    while (true)
-        if (ahead().tag() == Tag::K_import)
-            parse_import();
-        else if (ahead().tag() == Tag::K_plugin)
-            parse_plugin();
-        else
-            break;
+    recover([this] {
+        while (true)
+            if (ahead().tag() == Tag::K_import)
+                parse_import();
+            else if (ahead().tag() == Tag::K_plugin)
+                parse_plugin();
+            else
+                break;
+    });
 
-    parse_decls({});
-    expect(Tag::EoF, "module");
+    do {
+        recover([this] {
+            parse_decls({});
+            expect(Tag::EoF, "module");
+        });
+    } while (!ahead().isa(Tag::EoF));
 };
 
 void Parser::import(fs::path name, std::ostream* md) {
     world().VLOG("import: {}", name);
-    auto filename = name;
 
-    if (!filename.has_extension()) filename.replace_extension("thorin"); // TODO error cases
+    if (auto path = driver().add_import(driver().find_import(name), world().sym(name.string()))) {
+        auto begin = std::chrono::steady_clock::now();
+        std::unique_ptr<MMap> file;
+        if (auto i = prefetched_.find(path->string()); i != prefetched_.end()) {
+            file = std::move(i->second);
+            prefetched_.erase(i);
+        } else {
+            file = std::make_unique<MMap>(*path);
+        }
 
-    fs::path rel_path;
-    for (const auto& path : driver().search_paths()) {
-        rel_path = path / filename;
-        std::error_code ignore;
-        if (bool reg_file = fs::is_regular_file(rel_path, ignore); reg_file && !ignore) break;
+        std::istream is(*file ? file.get() : nullptr);
+        import(is, path, md);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+        world().VLOG("imported {} bytes in {}ms ({})", file->view().size(), ms.count(),
+                     file->is_mapped() ? "mmap" : "read");
     }
+}
+
+void Parser::import_parallel(fs::path name, std::ostream* md) {
+    using Clock = std::chrono::steady_clock;
+    auto begin  = Clock::now();
+    auto ms     = [&] { return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - begin).count(); };
+
+    // Discover the import graph wave by wave: each file of a wave is read and scanned in its own thread.
+    auto todo = std::vector<fs::path>{driver().find_import(name)};
+    absl::flat_hash_set<std::string> seen{todo.front().string()};
+    size_t num_waves = 0;
+    while (!todo.empty()) {
+        ++num_waves;
+        std::vector<std::unique_ptr<MMap>> files(todo.size());
+        std::vector<std::vector<std::string>> deps(todo.size());
+        {
+            std::vector<std::jthread> threads;
+            for (size_t i = 0, e = todo.size(); i != e; ++i)
+                threads.emplace_back([&, i] {
+                    files[i] = std::make_unique<MMap>(todo[i]);
+                    if (!*files[i]) return;
+
+                    // fault in all pages now - and not later during sequential parsing
+                    auto view          = files[i]->view();
+                    volatile char sink = 0;
+                    for (size_t j = 0; j < view.size(); j += 4096) sink = sink + view[j];
+
+                    deps[i] = scan_imports(view);
+                });
+        }
 
-    if (auto path = driver().add_import(std::move(rel_path), world().sym(name.string()))) {
-        auto ifs = std::ifstream(*path);
-        import(ifs, path, md);
+        std::vector<fs::path> next;
+        for (size_t i = 0, e = todo.size(); i != e; ++i) {
+            prefetched_[todo[i].string()] = std::move(files[i]);
+            for (const auto& dep_name : deps[i]) // Driver::find_import is not thread-safe
+                if (auto dep = driver().find_import(dep_name); seen.emplace(dep.string()).second) next.emplace_back(dep);
+        }
+        todo.swap(next);
     }
+    world().VLOG("prefetched {} files of import graph in {} waves in {}ms", prefetched_.size(), num_waves, ms());
+
+    // The World is not thread-safe; so parse in dependency order - just like Parser::import.
+    begin = Clock::now();
+    import(name, md);
+    world().VLOG("parsed import graph in {}ms", ms());
+    prefetched_.clear();
+}
+
+Manifest Parser::manifest(const fs::path& name) {
+    auto path = driver().find_import(name);
+    MMap file(path);
+    if (!file) error("cannot read file '{}'", path);
+    std::istream is(&file);
+    auto lexer = Lexer(world(), is, &path);
+    std::vector<Tok> toks;
+    for (auto tok = lexer.lex(); !tok.isa(Tag::EoF); tok = lexer.lex()) toks.emplace_back(tok);
+
+    Manifest res;
+    Fingerprint header;
+    size_t i = 0, n = toks.size();
+
+    // directives and - transitively - the contents of the imported files
+    std::vector<std::string> todo;
+    for (; i + 1 < n && (toks[i].isa(Tag::K_import) || toks[i].isa(Tag::K_plugin)); i += 3) {
+        auto sym = toks[i + 1].sym();
+        header.add(toks[i].isa(Tag::K_plugin)).add(sym.view());
+        todo.emplace_back(sym.view());
+        // as in Parser::plugin - we'll need it anyway
+        if (toks[i].isa(Tag::K_plugin) && !driver().flags().bootstrap && !driver().is_loaded(sym)) driver().load(sym);
+    }
+
+    auto num_imports = hash_imports(header, std::move(todo));
+    // the plugins' normalizers, passes, and backends shape the output just as much as their Thorin code
+    for (const auto& file : driver().plugin_files()) header.add_file(file);
+
+    // A declaration binds its name; a `.let` may bind anything left of its '=' as it may use a pattern.
+    // Mentions are not resolved against local scopes. Both over-approximate the dependencies but never miss one.
+    absl::flat_hash_map<std::string, std::vector<std::string>> binder2decls;
+    std::vector<std::pair<std::string, std::vector<std::string>>> mentions;
+    while (i != n) {
+        if (toks[i].isa(Tag::T_semicolon)) {
+            ++i;
+            continue;
+        }
+
+        auto begin = i;
+        for (int open = 0; i == begin || (open != 0 && i != n); ++i)
+            open += decl_nesting(toks[i].tag(), i == begin ? Tag::EoF : toks[i - 1].tag());
+        auto decl = std::span(toks).subspan(begin, i - begin);
+
+        std::ostringstream text;
+        std::vector<std::string> binders, mentioned;
+        bool lhs = true, let = decl.front().isa(Tag::K_let);
+        for (const auto& tok : decl) {
+            text << tok << ' ';
+            if (tok.isa(Tag::T_assign)) lhs = false;
+            if (!tok.isa(Tag::M_id) && !tok.isa(Tag::M_anx)) continue;
+            if (lhs && (let || binders.empty())) binders.emplace_back(tok.sym().str());
+            mentioned.emplace_back(tok.sym().str());
+        }
+
+        auto hash = Fingerprint().add(text.str()).get();
+        if (decl.front().isa(Tag::K_ax) || binders.empty() || binders.front().starts_with('%')) {
+            header.add(hash); // axioms and annexes may affect anything
+            continue;
+        }
+
+        auto& [h, external, _] = res.decls[binders.front()];
+        h = Fingerprint().add(h).add(hash).get(); // merges forward declarations
+        external |= decl.size() > 1 && decl[1].isa(Tag::K_extern);
+        for (const auto& binder : binders) binder2decls[binder].emplace_back(binders.front());
+        mentions.emplace_back(binders.front(), std::move(mentioned));
+    }
+
+    for (const auto& [name, mentioned] : mentions) {
+        auto& deps = res.decls[name].deps;
+        for (const auto& sym : mentioned)
+            if (auto i = binder2decls.find(sym); i != binder2decls.end())
+                for (const auto& decl : i->second)
+                    if (decl != name) deps.emplace_back(decl);
+        std::ranges::sort(deps);
+        deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+    }
+
+    res.header = header.get();
+    world().VLOG("manifest of '{}': {} declarations, {} imported files", path, res.decls.size(), num_imports);
+    return res;
+}
+
+size_t Parser::hash_imports(Fingerprint& fp, std::vector<std::string> todo) {
+    absl::flat_hash_set<std::string> seen;
+    while (!todo.empty()) {
+        auto imported = driver().find_import(todo.back());
+        todo.pop_back();
+        if (!seen.emplace(imported.string()).second) continue;
+        if (MMap src(imported); src) {
+            fp.add(imported.string()).add(src.view());
+            std::vector<std::string> plugins;
+            for (auto&& dep : scan_imports(src.view(), &plugins)) todo.emplace_back(std::move(dep));
+            for (const auto& plugin : plugins) // as in Parser::plugin - we'll need them anyway
+                if (auto sym = driver().sym(plugin); !driver().flags().bootstrap && !driver().is_loaded(sym))
+                    driver().load(sym);
+        }
+    }
+    return seen.size();
 }
 
 void Parser::import(std::istream& is, const fs::path* path, std::ostream* md) {
     world().VLOG("reading: {}", path ? path->string() : "<unknown file>"s);
     if (!is) error("cannot read file '{}'", *path);
 
-    auto state = std::tuple(prev_, ahead_, lexer_);
-    auto lexer = Lexer(world(), is, path, md);
-    lexer_     = &lexer;
-    init(path);
-    parse_module();
-    std::tie(prev_, ahead_, lexer_) = state;
+    std::istringstream src;
+    if (md) { // Markdown needs the raw text; so only slurp it in this case
+        src.str(std::string(std::istreambuf_iterator<char>(is), {}));
+        emit_md(world(), src.view(), path, *md);
+    }
+
+    auto state = std::tuple(prev_, ahead_, source_, depth_);
+    auto lexer = Lexer(world(), md ? src : is, path);
+    source_    = {&lexer};
+    ++depth_;
+    try {
+        init(path);
+        parse_module();
+    } catch (...) {
+        std::tie(prev_, ahead_, source_, depth_) = state; // Parser::recover may carry on with the importing module
+        throw;
+    }
+    std::tie(prev_, ahead_, source_, depth_) = state;
 }
 
 void Parser::plugin(fs::path path) {
@@ -764,6 +1059,11 @@ std::unique_ptr<TuplePtrn> Parser::parse_tuple_ptrn(Tracker track, bool rebind,
 
 Ref Parser::parse_decls(std::string_view ctxt) {
     while (true) {
+        if (is_lazy_decl()) {
+            parse_lazy_decl();
+            continue;
+        }
+
         // clang-format off
         switch (ahead().tag()) {
             case Tag::T_semicolon: lex();              break; // eat up stray semicolons
@@ -780,6 +1080,55 @@ Ref Parser::parse_decls(std::string_view ctxt) {
     }
 }
 
+bool Parser::is_lazy_decl() {
+    if (!driver().flags().lazy_imports || depth_ < 2 || !scopes_.is_root()) return false;
+    if (!ahead().isa(Tag::K_let) && !ahead().isa(Tag::K_lam) && !ahead().isa(Tag::K_con) && !ahead().isa(Tag::K_fun))
+        return false;
+    // annexes and .extern%s have to be registered right away; redeclarations resolve their forward declaration
+    auto& name = ahead(1);
+    return name.isa(Tag::M_id) && name.sym() != anonymous_ && !scopes_.is_declared(name.sym());
+}
+
+void Parser::parse_lazy_decl() {
+    auto toks = std::make_shared<std::vector<Tok>>();
+    for (int open = 0; toks->empty() || open != 0;) {
+        if (ahead().isa(Tag::EoF)) syntax_err("';'", "declaration");
+        auto tok = lex();
+        open += decl_nesting(tok.tag(), toks->empty() ? Tag::EoF : toks->back().tag());
+        toks->emplace_back(tok);
+    }
+
+    auto elaborate = [this, toks]() {
+        auto state = std::tuple(prev_, ahead_, source_);
+        source_    = {nullptr, toks.get()};
+        try {
+            init(toks->front().loc().path);
+            if (ahead().isa(Tag::K_let))
+                parse_let_decl();
+            else
+                parse_lam(true);
+            expect(Tag::EoF, "declaration");
+        } catch (...) {
+            std::tie(prev_, ahead_, source_) = state; // the error surfaces in the middle of another declaration
+            throw;
+        }
+        std::tie(prev_, ahead_, source_) = state;
+    };
+
+    // a let pattern like `x::(a, b)` binds more than its name; Look_Ahead doesn't suffice to see this earlier
+    auto& next = (*toks)[2];
+    if (toks->front().isa(Tag::K_let) && !next.isa(Tag::T_colon) && !next.isa(Tag::T_assign))
+        elaborate();
+    else
+        scopes_.bind_lazy((*toks)[1].dbg(), std::move(elaborate));
+}
+
+Tok Parser::Source::lex() {
+    auto tok = lexer ? lexer->lex() : i != toks->size() ? (*toks)[i++] : Tok(toks->back().loc().anew_finis(), Tag::EoF);
+    nesting += delim_nesting(tok.tag());
+    return tok;
+}
+
 void Parser::parse_ax_decl() {
     auto track = tracker();
     eat(Tag::K_ax);
@@ -6,10 +6,15 @@
 
 #include "thorin/fe/ast.h"
 #include "thorin/fe/lexer.h"
+#include "thorin/fe/manifest.h"
 #include "thorin/fe/scopes.h"
 
+#include "thorin/util/mmap.h"
+
 namespace thorin {
 
+class Fingerprint;
+
 constexpr size_t Look_Ahead = 2;
 
 /// Parses Thorin code into the provided World.
@@ -41,12 +46,36 @@ public:
     Driver& driver() { return world().driver(); }
     void import(fs::path, std::ostream* md = nullptr);
     void import(std::istream&, const fs::path* = nullptr, std::ostream* md = nullptr);
+    /// Same as `import(fs::path, std::ostream*)` but first discovers the whole import graph:
+    /// All files of a level in this graph are read and scanned for `.import`/`.plugin` directives in parallel.
+    /// Then, the files are parsed into the World in dependency order.
+    void import_parallel(fs::path, std::ostream* md = nullptr);
     void plugin(fs::path);
-    const Scopes& scopes() const { return scopes_; }
+    /// Lexes - but doesn't parse - the module @p name and summarizes its top-level declarations.
+    /// Imported modules are only hashed as a whole; plugins of `.plugin` directives are loaded as with Parser::plugin.
+    Manifest manifest(const fs::path& name);
+    /// Adds the contents of the modules @p names and - transitively - of all modules they import to @p fp.
+    /// As with Parser::manifest, nothing is parsed but the plugins of `.plugin` directives are loaded.
+    /// Hash Driver::plugin_files afterwards to also take their shared objects into account.
+    /// @returns the number of hashed files.
+    size_t hash_imports(Fingerprint& fp, std::vector<std::string> names);
+    Scopes& scopes() { return scopes_; }
+    const std::vector<std::string>& errors() const { return errors_; } ///< Collected with Flags::recover.
 
 private:
     Dbg dbg(const Tracker& tracker, Sym sym) const { return {tracker.loc(), sym}; }
-    Lexer& lexer() { return *lexer_; }
+
+    /// Feeds the Parser either from a Lexer or replays previously recorded Tok%ens - see Parser::parse_lazy_decl.
+    struct Source {
+        Tok lex();
+
+        Lexer* lexer                 = nullptr;
+        const std::vector<Tok>* toks = nullptr;
+        size_t i                     = 0;
+        int nesting                  = 0; ///< Opening minus closing delimiters lexed so far.
+    };
+
+    Source& lexer() { return source_; }
 
     /// @name parse misc
     ///@{
@@ -111,6 +140,11 @@ private:
     void parse_let_decl();
     void parse_sigma_decl();
     void parse_pi_decl();
+
+    /// With Flags::lazy_imports, a named `.let`/`.lam`/`.con`/`.fun` at the top level of an imported module is only
+    /// recorded as Tok%ens and bound via Scopes::bind_lazy; its body gets parsed once Scopes::find resolves its name.
+    bool is_lazy_decl();
+    void parse_lazy_decl();
     ///@}
 
     /// @name error messages
@@ -129,12 +163,21 @@ private:
         msg.append(Tok::tag2str(tag)).append("'");
         syntax_err(msg, ctxt);
     }
+
+    /// With Flags::recover, an error raised by @p f is appended to Parser::errors instead.
+    /// Then, the Parser skips to the next declaration, i.e. `.ax`, `.let`, `.Pi`, `.Sigma`, `.con`, `.fun`, or `.lam`,
+    /// that is nested in as many delimiters as the start of @p f was - declarations in the erroneous body are skipped.
+    template<class F> void recover(F f);
+    int nesting(); ///< Opening minus closing delimiters consumed so far in the current Source.
     ///@}
 
     World& world_;
-    Lexer* lexer_ = nullptr;
+    Source source_;
+    size_t depth_ = 0; ///< Nesting depth of Parser::import; `1` is the main module.
     Scopes scopes_;
     Def2Fields def2fields_;
+    absl::flat_hash_map<std::string, std::unique_ptr<MMap>> prefetched_; ///< See Parser::import_parallel.
+    std::vector<std::string> errors_;
     Sym anonymous_;
     Sym return_;
 
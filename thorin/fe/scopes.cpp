@@ -1,5 +1,7 @@
 #include "thorin/fe/scopes.h"
 
+#include <utility>
+
 #include "thorin/world.h"
 
 namespace thorin {
@@ -9,16 +11,36 @@ void Scopes::pop() {
     scopes_.pop_back();
 }
 
-const Def* Scopes::query(Dbg dbg) const {
+const Def* Scopes::query(Dbg dbg) {
     if (dbg.sym == '_') return nullptr;
 
-    for (auto& scope : scopes_ | std::ranges::views::reverse)
-        if (auto i = scope.find(dbg.sym); i != scope.end()) return i->second.second;
+    for (size_t i = scopes_.size(); i-- != floor_;)
+        if (auto j = scopes_[i].find(dbg.sym); j != scopes_[i].end()) return j->second.second;
+
+    auto& root = scopes_.front();
+    if (floor_ != 0)
+        if (auto i = root.find(dbg.sym); i != root.end()) return i->second.second;
+
+    if (auto i = lazy_.find(dbg.sym); i != lazy_.end()) {
+        auto lazy = std::move(i->second.second);
+        lazy_.erase(i); // before invoking lazy as it will bind dbg.sym
+
+        // Hide all scopes but the root from lazy and move its bindings to the root afterwards.
+        auto floor = std::exchange(floor_, scopes_.size());
+        push();
+        lazy();
+        auto top = std::move(scopes_.back());
+        pop();
+        floor_ = floor;
+        for (auto&& [sym, binding] : top) root.emplace(sym, binding);
+
+        if (auto i = root.find(dbg.sym); i != root.end()) return i->second.second;
+    }
 
     return nullptr;
 }
 
-const Def* Scopes::find(Dbg dbg) const {
+const Def* Scopes::find(Dbg dbg) {
     if (dbg.sym == '_') error(dbg.loc, "the symbol '_' is special and never binds to anything");
     if (auto res = query(dbg)) return res;
     error(dbg.loc, "'{}' not found", dbg.sym);
@@ -28,6 +50,11 @@ void Scopes::bind(Scope* scope, Dbg dbg, const Def* def, bool rebind) {
     auto [loc, sym] = dbg;
     if (sym == '_') return; // don't do anything with '_'
 
+    if (auto i = lazy_.find(sym); i != lazy_.end() && scope == &scopes_.front()) {
+        auto prev = i->second.first;
+        error(loc, "redeclaration of '{}'; previous declaration here: {}", sym, prev);
+    }
+
     if (rebind) {
         (*scope)[sym] = std::pair(loc, def);
     } else if (auto [i, ins] = scope->emplace(sym, std::pair(loc, def)); !ins) {
@@ -36,4 +63,12 @@ void Scopes::bind(Scope* scope, Dbg dbg, const Def* def, bool rebind) {
     }
 }
 
+void Scopes::bind_lazy(Dbg dbg, Lazy lazy) {
+    auto [loc, sym] = dbg;
+    if (auto [i, ins] = lazy_.emplace(sym, std::pair(loc, std::move(lazy))); !ins) {
+        auto prev = i->second.first;
+        error(loc, "redeclaration of '{}'; previous declaration here: {}", sym, prev);
+    }
+}
+
 } // namespace thorin
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <deque>
+#include <functional>
 
 #include "thorin/util/dbg.h"
 
@@ -12,20 +13,34 @@ class Ptrn;
 class Scopes {
 public:
     using Scope = fe::SymMap<std::pair<Loc, const Def*>>;
+    using Lazy  = std::function<void()>;
 
     Scopes() { push(); /* root scope */ }
 
     void push() { scopes_.emplace_back(); }
     void pop();
     Scope* curr() { return &scopes_.back(); }
-    const Def* query(Dbg) const;
-    const Def* find(Dbg) const; ///< Same as Scopes::query but potentially raises an error.
+    bool is_root() const { return scopes_.size() == 1; }
+    void unwind() { scopes_.resize(1); floor_ = 0; } ///< Drops all scopes but the root - e.g. after an error.
+    const Def* query(Dbg); ///< Elaborates a pending Scopes::bind_lazy binding of @p dbg, if necessary.
+    const Def* find(Dbg);  ///< Same as Scopes::query but potentially raises an error.
     void bind(Scope*, Dbg, const Def*, bool rebind = false);
     void bind(Dbg dbg, const Def* def, bool rebind = false) { bind(&scopes_.back(), dbg, def, rebind); }
     void swap(Scope& other) { std::swap(scopes_.back(), other); }
 
+    /// @name Lazy Bindings
+    ///@{
+    /// Scopes::query invokes @p lazy as soon as it looks for @p dbg in vain; @p lazy is supposed to Scopes::bind it.
+    /// @p lazy sees only the root scope - just like a declaration at the top level of a module.
+    void bind_lazy(Dbg dbg, Lazy lazy);
+    /// Is @p sym bound in the root scope or pending via Scopes::bind_lazy? Doesn't invoke anything.
+    bool is_declared(Sym sym) const { return scopes_.front().contains(sym) || lazy_.contains(sym); }
+    ///@}
+
 private:
     std::deque<Scope> scopes_;
+    size_t floor_ = 0; ///< Scopes::query ignores all scopes below this index but the root.
+    fe::SymMap<std::pair<Loc, Lazy>> lazy_;
 };
 
 } // namespace thorin
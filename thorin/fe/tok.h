@@ -54,6 +54,7 @@ constexpr auto Num_Keys = size_t(0) THORIN_KEY(CODE);
     m(M_id,   "<identifier>")          \
     m(M_anx,  "<annex name>")          \
     m(M_str,  "<string>"    )          \
+    m(M_doc,  "<doc comment>")         \
     /* delimiters */                   \
     m(D_angle_l,    "‹")               \
     m(D_angle_r,    "›")               \
@@ -167,7 +168,7 @@ public:
         : loc_(loc)
         , tag_(tag)
         , sym_(sym) {
-        assert(tag == Tag::M_id || tag == Tag::M_anx || tag == Tag::M_str);
+        assert(tag == Tag::M_id || tag == Tag::M_anx || tag == Tag::M_str || tag == Tag::M_doc);
     }
 
     bool isa(Tag tag) const { return tag == tag_; }
@@ -178,7 +179,7 @@ public:
     const Lit* lit_i() const { assert(isa(Tag::L_i)); return i_; }
     char8_t    lit_c() const { assert(isa(Tag::L_c)); return c_;   }
     u64        lit_u() const { assert(isa(Tag::L_u ) || isa(Tag::L_s ) || isa(Tag::L_f  )); return u_;   }
-    Sym        sym()   const { assert(isa(Tag::M_anx) || isa(Tag::M_id) || isa(Tag::M_str)); return sym_; }
+    Sym        sym()   const { assert(isa(Tag::M_anx) || isa(Tag::M_id) || isa(Tag::M_str) || isa(Tag::M_doc)); return sym_; }
     // clang-format on
     friend std::ostream& operator<<(std::ostream&, Tok);
 
@@ -11,10 +11,16 @@ namespace thorin {
 struct Flags {
     uint32_t dump_gid            = 0;
     uint64_t scalerize_threshold = 32;
+    uint32_t ll_partitions       = 1; // number of LLVM modules compiled in parallel for an executable; see ll::compile
     bool dump_recursive          = false;
     bool disable_type_checking   = false; // TODO implement this flag
     bool bootstrap               = false;
     bool aggressive_lam_spec     = false; // HACK makes LamSpec more agressive but potentially non-terminating
+    bool stream_ll               = false;
+    bool instrument              = false; // emits per-basic-block execution counters; see Profile
+    bool lazy_imports            = false; // elaborates named .let/.lam declarations of imports upon first use
+    bool recover                 = false; // collects all errors while parsing instead of aborting upon the first one
+    bool loop_hints              = false; // forces vectorization and unrolling of counted loops in the LLVM output
 #ifdef THORIN_ENABLE_CHECKS
     bool reeval_breakpoints     = false;
     bool trace_gids             = false;
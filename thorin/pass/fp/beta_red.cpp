@@ -1,11 +1,19 @@
 #include "thorin/pass/fp/beta_red.h"
 
+#include "thorin/driver.h"
 #include "thorin/rewrite.h"
 
 namespace thorin {
 
 Ref BetaRed::rewrite(Ref def) {
     if (auto [app, lam] = isa_apped_mut_lam(def); isa_workable(lam) && !keep_.contains(lam)) {
+        // keep cold code out of hot code
+        if (auto& profile = world().driver().profile(); profile.is_cold(lam) && profile.is_hot(curr_mut())) {
+            world().DLOG("keep cold '{}' out of hot '{}'", lam, curr_mut());
+            keep_.emplace(lam);
+            return def;
+        }
+
         if (auto [_, ins] = data().emplace(lam); ins) {
             world().DLOG("beta-reduction {}", lam);
             return lam->reduce(app->arg()).back();
@@ -6,6 +6,7 @@ namespace thorin {
 
 /// Optimistically performs β-reduction (aka inlining).
 /// β-reduction of `f e` happens if `f` only occurs exactly once in the program in callee position.
+/// According to the Driver::profile, a cold `f` is not inlined into a hot Lam.
 class BetaRed : public FPPass<BetaRed, Def> {
 public:
     BetaRed(PassMan& man)
@@ -1,5 +1,7 @@
 #include "thorin/pass/rw/lam_spec.h"
 
+#include "thorin/driver.h"
+
 #include "thorin/analyses/scope.h"
 #include "thorin/pass/fp/beta_red.h"
 #include "thorin/pass/fp/eta_exp.h"
@@ -40,8 +42,12 @@ Ref LamSpec::rewrite(Ref def) {
 
     // Skip recursion to avoid infinite inlining if not "aggressive_lam_spec".
     // This is a hack - but we want to get rid off this Pass anyway.
+    // A hot Lam is specialized nonetheless - but only once as its specialization will still call the original.
     Scope scope(old_lam);
-    if (!world().flags().aggressive_lam_spec && scope.free_defs().contains(old_lam)) return def;
+    if (!world().flags().aggressive_lam_spec && scope.free_defs().contains(old_lam)) {
+        if (!world().driver().profile().is_hot(old_lam) || !peeled_.emplace(old_lam).second) return def;
+        world().DLOG("specialize hot recursive '{}' once", old_lam);
+    }
 
     DefVec new_doms, new_vars, new_args;
     auto skip     = old_lam->ret_var() && is_top_level(old_lam);
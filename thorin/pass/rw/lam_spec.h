@@ -16,6 +16,7 @@ private:
     ///@}
 
     Def2Def old2new_;
+    LamSet peeled_; ///< Hot recursive Lam%s that have already been specialized once.
 };
 
 } // namespace thorin
@@ -1,5 +1,6 @@
 #include "thorin/pass/rw/scalarize.h"
 
+#include "thorin/driver.h"
 #include "thorin/rewrite.h"
 #include "thorin/tuple.h"
 
@@ -14,6 +15,12 @@ bool Scalerize::should_expand(Lam* lam) {
     if (!isa_workable(lam)) return false;
     if (auto i = tup2sca_.find(lam); i != tup2sca_.end() && i->second && i->second == lam) return false;
 
+    if (world().driver().profile().is_cold(lam)) { // not worth the code growth
+        world().DLOG("don't scalerize cold '{}'", lam);
+        tup2sca_[lam] = lam;
+        return false;
+    }
+
     auto pi = lam->type();
     if (lam->num_doms() > 1 && Pi::isa_cn(pi) && pi->isa_imm()) return true; // no ugly dependent pis
 
@@ -15,7 +15,7 @@ class EtaExp;
 /// f' := λ (y_1:T_1, y_2:T2, .. y_n:T_n).E[x_1 \ (y_1, y2); ..; x_n \ y_n]
 /// ```
 /// if `f` appears in callee position only (see @p EtaExp).
-/// It will not flatten mutable @p Sigma%s or @p Arr%ays.
+/// It will not flatten mutable @p Sigma%s or @p Arr%ays - nor Lam%s that are cold according to the Driver::profile.
 class Scalerize : public RWPass<Scalerize, Lam> {
 public:
     Scalerize(PassMan& man, EtaExp* eta_exp)
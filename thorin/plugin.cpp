@@ -6,6 +6,35 @@ using namespace std::literals;
 
 namespace thorin {
 
+namespace {
+absl::flat_hash_map<std::string, GetPlugin>& static_plugins() {
+    static absl::flat_hash_map<std::string, GetPlugin> plugins; // constructed on first use by a static initializer
+    return plugins;
+}
+} // namespace
+
+void register_static_plugin(std::string name, GetPlugin get) { static_plugins()[std::move(name)] = get; }
+GetPlugin static_plugin(std::string_view name) { return lookup(static_plugins(), std::string(name)); }
+
+NormalizeFn& Normalizers::operator[](flags_t flags) {
+    auto& table = plugin2table_[Annex::flags2plugin(flags)];
+    auto tag    = Annex::flags2tag(flags);
+    auto sub    = Annex::flags2sub(flags);
+    if (tag >= table.size()) table.resize(tag + 1);
+    if (sub >= table[tag].size()) table[tag].resize(sub + 1, nullptr);
+    return table[tag][sub];
+}
+
+NormalizeFn Normalizers::find(flags_t flags) const {
+    if (auto i = plugin2table_.find(Annex::flags2plugin(flags)); i != plugin2table_.end()) {
+        const auto& table = i->second;
+        auto tag          = Annex::flags2tag(flags);
+        auto sub          = Annex::flags2sub(flags);
+        if (tag < table.size() && sub < table[tag].size()) return table[tag][sub];
+    }
+    return nullptr;
+}
+
 std::optional<plugin_t> Annex::mangle(Sym s) {
     auto n = s.size();
     if (n > Max_Plugin_Size) return {};
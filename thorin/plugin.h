@@ -13,14 +13,37 @@
 namespace thorin {
 
 class PipelineBuilder;
+namespace ll {
+class Lowerer;
+}
+
+/// Maps axiom ids to their NormalizeFn.
+/// As the tags of a Plugin and the subs of a tag are numbered densely (see bootstrap), each Plugin registers a Table
+/// indexed by tag and sub. Hence, a lookup boils down to finding the Plugin and two array indexings.
+class Normalizers {
+public:
+    using Table = std::vector<std::vector<NormalizeFn>>; ///< `tag ↦ sub ↦ normalizer`
+
+    /// Registers the whole Table of @p plugin as generated by bootstrap.
+    void add(plugin_t plugin, Table table) { plugin2table_[plugin] = std::move(table); }
+    /// Slot of a single axiom id for hand-written registration functions; grows the Table as needed.
+    NormalizeFn& operator[](flags_t flags);
+    /// @returns `nullptr` if there is no normalizer registered for @p flags.
+    NormalizeFn find(flags_t flags) const;
+
+private:
+    absl::flat_hash_map<plugin_t, Table> plugin2table_;
+};
 
 /// @name Plugin Interface
 ///@{
-using Normalizers = absl::flat_hash_map<flags_t, NormalizeFn>;
 /// `axiom ↦ (pipeline part) × (axiom application) → ()` <br/>
 /// The function should inspect App%lication to construct the Pass/Phase and add it to the pipeline.
 using Passes   = absl::flat_hash_map<flags_t, std::function<void(World&, PipelineBuilder&, const Def*)>>;
 using Backends = absl::btree_map<std::string, void (*)(World&, std::ostream&)>;
+/// `axiom ↦ (LLVM backend) × (axiom application) × (name of the result) → (LLVM value)` <br/>
+/// Lowers a fully applied Axiom to LLVM IR; keyed by Annex::flags2base, so all subtags share one rule.
+using Lowerings = absl::flat_hash_map<flags_t, std::string (*)(ll::Lowerer&, const Def*, const std::string& name)>;
 ///@}
 
 extern "C" {
@@ -37,6 +60,8 @@ struct Plugin {
     void (*register_passes)(Passes& passes);
     /// Callback for registering the mapping from backend names to emission functions in the given @p backends map.
     void (*register_backends)(Backends& backends);
+    /// Callback for registering the LLVM lowerings of the Plugin's Axiom%s in the given @p lowerings map.
+    void (*register_lowerings)(Lowerings& lowerings);
 };
 
 /// @name Plugin Interface
@@ -49,6 +74,15 @@ THORIN_EXPORT thorin::Plugin thorin_get_plugin();
 ///@}
 }
 
+/// @name Static Plugins
+/// Plugins that are linked into the executable (see `THORIN_STATIC_PLUGINS`) register their `thorin_get_plugin` here.
+/// Driver::load consults this registry before searching the file system.
+///@{
+using GetPlugin = Plugin (*)();
+void register_static_plugin(std::string name, GetPlugin);
+GetPlugin static_plugin(std::string_view name); ///< `nullptr` if @p name has not been registered.
+///@}
+
 /// Holds info about an entity defined within a Plugin (called *Annex*).
 struct Annex {
     Annex(Sym plugin, Sym tag, flags_t tag_id)
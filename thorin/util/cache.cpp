@@ -0,0 +1,101 @@
+#include "thorin/util/cache.h"
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "thorin/util/print.h"
+#include "thorin/util/sys.h"
+
+namespace thorin {
+
+static constexpr const char* Stats_File = "stats";
+
+Cache::Cache(fs::path dir, size_t capacity)
+    : dir_(std::move(dir))
+    , capacity_(capacity) {
+    std::error_code ec;
+    fs::create_directories(dir_, ec);
+    std::ifstream ifs(dir_ / Stats_File);
+    for (Stats run; ifs >> run.hits >> run.misses >> run.evictions;) {
+        total_.hits += run.hits;
+        total_.misses += run.misses;
+        total_.evictions += run.evictions;
+    }
+}
+
+Cache::~Cache() {
+    // a single, short write in append mode doesn't interleave with those of concurrent runs
+    auto line = fmt("{} {} {}\n", stats_.hits, stats_.misses, stats_.evictions);
+    if (std::ofstream ofs(dir_ / Stats_File, std::ios::app); ofs) ofs.write(line.data(), line.size());
+}
+
+std::optional<std::string> Cache::lookup(const std::string& key) {
+    auto path = dir_ / key;
+    if (std::ifstream ifs(path, std::ios::binary); ifs) {
+        std::ostringstream oss;
+        oss << ifs.rdbuf();
+        if (ifs.good() || ifs.eof()) {
+            std::error_code ec;
+            fs::last_write_time(path, fs::file_time_type::clock::now(), ec); // mark as recently used
+            ++stats_.hits, ++total_.hits;
+            return oss.str();
+        }
+    }
+
+    ++stats_.misses, ++total_.misses;
+    return {};
+}
+
+void Cache::insert(const std::string& key, std::string_view data) {
+    // write to a temporary first so concurrent compiler invocations never observe a partial entry;
+    // its name is unique as concurrent invocations may insert the very same key
+    auto path = dir_ / key;
+    auto tmp  = fs::path(path).concat(fmt(".{}.{}.tmp", sys::pid(), std::random_device()()));
+    {
+        std::ofstream ofs(tmp, std::ios::binary);
+        if (!ofs.write(data.data(), data.size())) return;
+    }
+
+    std::error_code ec;
+    fs::rename(tmp, path, ec);
+    if (ec) return (void)fs::remove(tmp, ec);
+    evict();
+}
+
+void Cache::evict() {
+    struct Entry {
+        fs::path path;
+        fs::file_time_type time;
+        size_t size;
+    };
+
+    std::error_code ec;
+    std::vector<Entry> entries;
+    size_t total = 0;
+    for (const auto& file : fs::directory_iterator(dir_, ec)) {
+        const auto& path = file.path();
+        if (!file.is_regular_file(ec) || path.filename() == Stats_File || path.extension() == ".tmp") continue;
+        auto size = file.file_size(ec);
+        if (ec) continue;
+        auto time = file.last_write_time(ec);
+        if (ec) continue;
+        entries.emplace_back(path, time, size);
+        total += size;
+    }
+
+    if (total <= capacity_) return;
+
+    std::ranges::sort(entries, {}, &Entry::time); // least recently used first
+    for (const auto& entry : entries) {
+        if (total <= capacity_) break;
+        if (fs::remove(entry.path, ec)) {
+            total -= entry.size;
+            ++stats_.evictions, ++total_.evictions;
+        }
+    }
+}
+
+} // namespace thorin
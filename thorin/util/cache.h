@@ -0,0 +1,47 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "thorin/util/types.h"
+
+namespace thorin {
+
+namespace fs = std::filesystem;
+
+/// Content-addressed on-disk cache in directory @p dir.
+/// Each entry is a file whose name is the key; Cache::lookup refreshes its modification time.
+/// After each Cache::insert, the least recently used entries are evicted until the cache fits into its capacity.
+/// All file system errors are swallowed: A cache that doesn't work merely yields misses.
+class Cache {
+public:
+    struct Stats {
+        u64 hits      = 0;
+        u64 misses    = 0;
+        u64 evictions = 0;
+    };
+
+    /// Statistics accumulate across runs in the file `stats` within @p dir:
+    /// Each run appends its own counts as a line, so concurrent runs don't overwrite each other's.
+    Cache(fs::path dir, size_t capacity = 256_s * 1024_s * 1024_s);
+    ~Cache();
+
+    std::optional<std::string> lookup(const std::string& key);
+    void insert(const std::string& key, std::string_view data);
+
+    const fs::path& dir() const { return dir_; }
+    size_t capacity() const { return capacity_; }
+    const Stats& stats() const { return stats_; }
+    const Stats& total() const { return total_; } ///< Including all previous runs.
+
+private:
+    void evict();
+
+    fs::path dir_;
+    size_t capacity_;
+    Stats stats_;
+    Stats total_;
+};
+
+} // namespace thorin
@@ -0,0 +1,53 @@
+#include "thorin/util/mmap.h"
+
+#include <fstream>
+#include <sstream>
+
+#ifndef _WIN32
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace thorin {
+
+MMap::MMap(const fs::path& path) {
+#ifndef _WIN32
+    if (int fd = ::open(path.c_str(), O_RDONLY); fd != -1) {
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+            size_ = st.st_size;
+            if (size_ == 0) {
+                ok_ = true; // mmap refuses empty files
+            } else if (auto p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0); p != MAP_FAILED) {
+                ::madvise(p, size_, MADV_SEQUENTIAL);
+                data_ = static_cast<char*>(p);
+                ok_ = mapped_ = true;
+            }
+        }
+        ::close(fd);
+    }
+#endif
+
+    if (!ok_) {
+        if (std::ifstream ifs(path, std::ios::binary); ifs) {
+            std::ostringstream oss;
+            oss << ifs.rdbuf();
+            buffer_ = std::move(oss).str();
+            data_   = buffer_.data();
+            size_   = buffer_.size();
+            ok_     = true;
+        }
+    }
+
+    setg(data_, data_, data_ + size_);
+}
+
+MMap::~MMap() {
+#ifndef _WIN32
+    if (mapped_) ::munmap(data_, size_);
+#endif
+}
+
+} // namespace thorin
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <filesystem>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace thorin {
+
+namespace fs = std::filesystem;
+
+/// Maps a file read-only into memory and serves it as `std::streambuf` - without copying it into a buffer.
+/// Falls back to reading the whole file at once, if the platform or the file (e.g., a pipe) doesn't support mapping.
+/// ```
+/// MMap file(path);
+/// if (!file) error("cannot read file '{}'", path);
+/// std::istream is(&file);
+/// ```
+class MMap : public std::streambuf {
+public:
+    explicit MMap(const fs::path&);
+    MMap(const MMap&)            = delete;
+    MMap& operator=(const MMap&) = delete;
+    ~MMap() override;
+
+    explicit operator bool() const { return ok_; }
+    std::string_view view() const { return {data_, size_}; } ///< The whole file.
+    bool is_mapped() const { return mapped_; }
+
+private:
+    char* data_  = nullptr;
+    size_t size_ = 0;
+    bool ok_     = false;
+    bool mapped_ = false;
+    std::string buffer_; ///< Only used in fallback mode.
+};
+
+} // namespace thorin
@@ -51,6 +51,14 @@ std::optional<fs::path> path_to_curr_exe() {
     return {};
 }
 
+int pid() {
+#ifdef _WIN32
+    return int(GetCurrentProcessId());
+#else
+    return int(getpid());
+#endif
+}
+
 // see https://stackoverflow.com/a/478960
 std::string exec(std::string cmd) {
     std::array<char, 128> buffer;
@@ -18,6 +18,8 @@ namespace sys {
 
 std::optional<fs::path> path_to_curr_exe(); ///< Yields `std::nullopt` if an error occurred.
 
+int pid(); ///< Id of the current process.
+
 /// Executes command @p cmd.
 /// @returns the output as string.
 std::string exec(std::string cmd);
@@ -48,6 +48,7 @@ public:
             mutable bool frozen = false;
         } pod;
 
+        Check::Stats check_stats;
 #ifdef THORIN_ENABLE_CHECKS
         absl::flat_hash_set<uint32_t> breakpoints;
 #endif
@@ -55,6 +56,7 @@ public:
             using std::swap;
             assert((!s1.pod.loc || !s2.pod.loc) && "Why is emit_loc() still set?");
             swap(s1.pod, s2.pod);
+            swap(s1.check_stats, s2.check_stats);
 #ifdef THORIN_ENABLE_CHECKS
             swap(s1.breakpoints, s2.breakpoints);
 #endif
@@ -95,6 +97,9 @@ public:
     Flags& flags();
 
     Loc& emit_loc() { return state_.pod.loc; }
+
+    /// Counters of all Check::alpha queries in this World - including its predecessors (see World::inherit).
+    const Check::Stats& check_stats() const { return state_.check_stats; }
     ///@}
 
     /// @name Sym
@@ -533,14 +538,16 @@ private:
         absl::btree_map<Sym, Def*> externals;
         absl::flat_hash_set<const Def*, SeaHash, SeaEq> defs;
         DefDefMap<DefVec> cache;
+        DefMap<hash_t> check_hashes; ///< See Check::hash.
 
         friend void swap(Move& m1, Move& m2) noexcept {
             using std::swap;
             // clang-format off
-            swap(m1.annexes,   m2.annexes);
-            swap(m1.externals, m2.externals);
-            swap(m1.defs,      m2.defs);
-            swap(m1.cache,     m2.cache);
+            swap(m1.annexes,      m2.annexes);
+            swap(m1.externals,    m2.externals);
+            swap(m1.defs,         m2.defs);
+            swap(m1.cache,        m2.cache);
+            swap(m1.check_hashes, m2.check_hashes);
             // clang-format on
         }
     } move_;
@@ -583,6 +590,7 @@ private:
     }
 
     friend DefVec Def::reduce(const Def*);
+    friend class Check;
 };
 
 } // namespace thorin